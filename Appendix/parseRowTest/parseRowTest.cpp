@@ -1,4 +1,19 @@
 
+/*
+ * Correctness and throughput test of the CSV tokenizer
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Checks tokenizeRow() and parseField() against
+ *                     known rows and reports the throughput in MB/s
+ *
+ */
+
+
 //
 // Local includes
 //
@@ -18,8 +33,111 @@
 // Standard Includes
 //
 
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <string_view>
+
+
+//
+// Structure: TokenCase
+//
+
+struct TokenCase {
+	std::string line;
+	std::vector<std::string> expected;
+};
+
+
+//
+// Function: checkTokens()
+//
+// Returns:
+//    Number of failed cases
+//
+
+int checkTokens() {
+
+	std::vector<TokenCase> cases = {
+		{ "This, is, a, test, string.", { "This", "is", "a", "test", "string." } },
+		{ "90, 1.0 / 12.0, 0.01", { "90", "1.0 / 12.0", "0.01" } },
+		{ "a,,b", { "a", "", "b" } },
+		{ "", { "" } },
+		{ ",", { "", "" } },
+		{ "\"quoted, comma\", next", { "quoted, comma", "next" } },
+		{ "  \"  padded  \"  ,x", { "padded", "x" } },
+		{ "\"a \"\"b\"\" c\",d", { "a \"\"b\"\" c", "d" } },
+		{ "2000-01-01, 1.13402\r", { "2000-01-01", "1.13402" } },
+		{ "abcdefghijklmnopqrstuvwxyz0123456789,abcdefghijklmnopqrstuvwxyz0123456789",
+			{ "abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnopqrstuvwxyz0123456789" } },
+		{ "\"0123456789012345,6789012345678901\",2", { "0123456789012345,6789012345678901", "2" } }
+	};
+
+	int failures = 0;
+	std::vector<std::string_view> fields;
+
+	for (auto& c : cases) {
+		tokenizeRow(c.line, &fields);
+
+		bool same = (fields.size() == c.expected.size());
+
+		for (size_t i = 0; same && (i < fields.size()); i++)
+			same = (fields[i] == c.expected[i]);
+
+		if (!same) {
+			failures++;
+			std::cout << "FAIL : tokenizeRow : " << c.line << std::endl;
+
+			for (auto f : fields)
+				std::cout << "TOKEN : [" << f << "]" << std::endl;
+		}
+	}
+
+	return failures;
+}
+
+
+//
+// Function: checkNumbers()
+//
+// Returns:
+//    Number of failed cases
+//
+
+int checkNumbers() {
+
+	struct NumberCase {
+		std::string field;
+		bool valid;
+		double expected;
+	};
+
+	std::vector<NumberCase> cases = {
+		{ "90", true, 90.0 },
+		{ " 0.01 ", true, 0.01 },
+		{ "-0.5", true, -0.5 },
+		{ "+1.5", true, 1.5 },
+		{ "1e-3", true, 0.001 },
+		{ "", false, 0.0 },
+		{ "abc", false, 0.0 },
+		{ "1.0 / 12.0", false, 0.0 },
+		{ "12abc", false, 0.0 }
+	};
+
+	int failures = 0;
+
+	for (auto& c : cases) {
+		double value = 0.0;
+		bool valid = parseField(c.field, &value);
+
+		if ((valid != c.valid) || (valid && (value != c.expected))) {
+			failures++;
+			std::cout << "FAIL : parseField : [" << c.field << "]" << std::endl;
+		}
+	}
+
+	return failures;
+}
 
 
 //
@@ -28,19 +146,52 @@
 
 int main(int argc, char* argv[]) {
 
-	// Each token is separated by a comma
-	std::string testString = "This, is, a, test, string.";
+	int failures = checkTokens() + checkNumbers();
+
+	//
+	// Throughput over a parameter file sized input
+	//
+
+	const unsigned int rows = 1000000;
+	std::vector<std::string> lines;
+	lines.reserve(rows);
 
-	auto p = parseRow(testString);
+	size_t bytes = 0;
 
-	std::cout << "TEST STRING : " << testString << std::endl;
+	for (auto i = 0u; i < rows; i++) {
+		lines.push_back(std::to_string(90 + i % 21) + ", 0.25, 0.01, 1.5, 0.15, -0.5, "
+			+ std::to_string(i) + ".0625, \"note, " + std::to_string(i) + "\"");
+		bytes += lines.back().size() + 1;
+	}
+
+	std::vector<std::string_view> fields;
+	double checksum = 0.0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (auto& line : lines) {
+		tokenizeRow(line, &fields);
+
+		for (size_t f = 0; f + 1 < fields.size(); f++) {
+			double value = 0.0;
 
-	for (auto e : p) {
-		std::cout << "TOKEN : " << e << std::endl;
+			if (parseField(fields[f], &value))
+				checksum += value;
+		}
 	}
 
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
+	std::cout << "Rows : " << rows << " : MB : " << bytes / 1.0e6
+		<< " : seconds : " << seconds << " : MB/s : " << bytes / 1.0e6 / seconds
+		<< " : checksum : " << checksum << std::endl;
+
+	if (failures > 0) {
+		std::cout << "FAILED : " << failures << std::endl;
+		return _FAIL_;
+	}
+
+	std::cout << "PASSED" << std::endl;
 
 	return _OKAY_;
 }
-
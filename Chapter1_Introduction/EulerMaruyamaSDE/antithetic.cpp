@@ -1,13 +1,27 @@
-#include <iostream>
-#include <iomanip>
+#include <math.h>
 #include <random>
 
+#include "Arena.h"
+#include "parseCommandLine.h"
+#include "Log.h"
+
 int main(int argc, char* argv[]) {
 
+	auto arguments = parseCommandLine(argc, argv);
+
+	if (arguments.count("log") > 0)
+		logSetLevel(logParseLevel(arguments["log"]));
+
+	if ((arguments.count("quiet") > 0) && (arguments["quiet"] != "0"))
+		logSetLevel(_LOG_OFF_);
+
 	std::default_random_engine  gen;
 	std::normal_distribution<double> dist(0.0, 1.0);
 
 
+	// Per step count buffers, released together at the end of each step count
+	Arena arena;
+
 	for (unsigned int steps = 2; steps < 10000; steps = steps * 2) {
 		const int metasamples = 1000;
 
@@ -20,13 +34,13 @@ int main(int argc, char* argv[]) {
 		double dt = T / static_cast<double>(steps);
 		double sqrtdt = sqrt(dt);
 
-		auto dataEM = new double[samples];
-		auto metameanEM = new double[metasamples];
-		auto metastdevEM = new double[metasamples];
+		auto dataEM = arena.allocate<double>(samples);
+		auto metameanEM = arena.allocate<double>(metasamples);
+		auto metastdevEM = arena.allocate<double>(metasamples);
 
-		auto dataMilstein = new double[samples];
-		auto metameanMilstein = new double[metasamples];
-		auto metastdevMilstein = new double[metasamples];
+		auto dataMilstein = arena.allocate<double>(samples);
+		auto metameanMilstein = arena.allocate<double>(metasamples);
+		auto metastdevMilstein = arena.allocate<double>(metasamples);
 
 		double XEM = 0.0, XEM1 = 0.0, XEM2 = 0.0, XMilstein = 0.0, XMilstein1 = 0.0, XMilstein2 = 0.0, dx = 0.0, dW1 = 0.0, dW2 = 0.0;
 
@@ -128,9 +142,9 @@ int main(int argc, char* argv[]) {
 		meanstdev = sqrt(meanstdev / static_cast<double>(metasamples));
 		stdevstdev = sqrt(stdevstdev / static_cast<double>(metasamples));
 
-		std::cout << "antithetic : Euler-Maruyama : dt : " << dt << " : "
-			<< "MEAN : mean: " << meanmean << " : stdev: " << meanstdev << " : "
-			<< "STD DEV : mean: " << stdevmean << " : stdev: " << stdevstdev << std::endl;
+		LogLine(_LOG_INFO_, "antithetic").field("scheme", "Euler-Maruyama").field("dt", dt)
+			.field("meanMean", meanmean).field("meanStdev", meanstdev)
+			.field("stdevMean", stdevmean).field("stdevStdev", stdevstdev);
 
 		//
 		// Milstein
@@ -157,9 +171,11 @@ int main(int argc, char* argv[]) {
 		meanstdev = sqrt(meanstdev / static_cast<double>(metasamples));
 		stdevstdev = sqrt(stdevstdev / static_cast<double>(metasamples));
 
-		std::cout << "antithetic : Milstein : dt : " << dt << " : "
-			<< "MEAN : mean: " << meanmean << " : stdev: " << meanstdev << " : "
-			<< "STD DEV : mean: " << stdevmean << " : stdev: " << stdevstdev << std::endl;
+		LogLine(_LOG_INFO_, "antithetic").field("scheme", "Milstein").field("dt", dt)
+			.field("meanMean", meanmean).field("meanStdev", meanstdev)
+			.field("stdevMean", stdevmean).field("stdevStdev", stdevstdev);
+
+		arena.reset();
 	}
 
 	return 0;
@@ -1,12 +1,81 @@
-#include <iostream>
-#include <iomanip>
+#include <math.h>
 #include <random>
 
+#include "PathKernel.h"
+#include "Arena.h"
+#include "parseCommandLine.h"
+#include "Log.h"
+
+
+//
+// Function: report()
+//
+// Parameters:
+//    pName - Scheme
+//    pdt - Step
+//    pMetamean, pMetastdev - Mean and standard deviation of every metasample
+//    pMetasamples - Number of metasamples
+//
+// Comments:
+//    Logs the mean and spread over the metasamples of both statistics
+//
+
+static void report(const char* pName, double pdt, const double* pMetamean, const double* pMetastdev, int pMetasamples) {
+
+	double meanmean = 0.0, meanstdev = 0.0, stdevmean = 0.0, stdevstdev = 0.0;
+
+	for (auto i = 0; i < pMetasamples; i++) {
+		meanmean += pMetamean[i];
+		stdevmean += pMetastdev[i];
+	}
+
+	meanmean = meanmean / static_cast<double>(pMetasamples);
+	stdevmean = stdevmean / static_cast<double>(pMetasamples);
+
+	for (auto i = 0; i < pMetasamples; i++) {
+		meanstdev += pow(pMetamean[i] - meanmean, 2.0);
+		stdevstdev += pow(pMetastdev[i] - stdevmean, 2.0);
+	}
+
+	meanstdev = sqrt(meanstdev / static_cast<double>(pMetasamples));
+	stdevstdev = sqrt(stdevstdev / static_cast<double>(pMetasamples));
+
+	LogLine(_LOG_INFO_, "sde").field("scheme", pName).field("dt", pdt)
+		.field("meanMean", meanmean).field("meanStdev", meanstdev)
+		.field("stdevMean", stdevmean).field("stdevStdev", stdevstdev);
+}
+
+
+//
+// Function: main()
+//
+// Parameters:
+//    -log=level - debug, info (the default), warn, error or off
+//    -quiet=1 - No output, for benchmark runs
+//
+
 int main(int argc, char *argv[]) {
 
-	std::default_random_engine  gen;
-	std::normal_distribution<double> dist(0.0, 1.0);
+	auto arguments = parseCommandLine(argc, argv);
+
+	if (arguments.count("log") > 0)
+		logSetLevel(logParseLevel(arguments["log"]));
+
+	if ((arguments.count("quiet") > 0) && (arguments["quiet"] != "0"))
+		logSetLevel(_LOG_OFF_);
+
+	const uint64_t seed = 1;
 
+	// GBM uses a single, uncorrelated factor
+	const std::array<std::array<double, 3>, 3> L = {{ {{ 1.0, 0.0, 0.0 }}, {{ 0.0, 1.0, 0.0 }}, {{ 0.0, 0.0, 1.0 }} }};
+
+	// Euler-Maruyama, Milstein and log-Euler, the last exact for GBM
+	const char* names[] = { "Euler-Maruyama", "Milstein", "Log-Euler" };
+	const int schemes = 3;
+
+
+	// Per step count buffers, released together at the end of each step count
+	Arena arena;
 
 	for (unsigned int steps = 2; steps < 10000; steps = steps * 2) {
 		const int metasamples = 1000;
@@ -18,17 +87,24 @@ int main(int argc, char *argv[]) {
 		const double volatility = 0.03;
 		
 		double dt = T / static_cast<double>(steps);
-		double sqrtdt = sqrt(dt);
-
-		auto dataEM = new double[samples];
-		auto metameanEM = new double[metasamples];
-		auto metastdevEM = new double[metasamples];
-
-		auto dataMilstein = new double[samples];
-		auto metameanMilstein = new double[metasamples];
-		auto metastdevMilstein = new double[metasamples];
 
-		double XEM = 0.0, XMilstein = 0.0, dx = 0.0, dW = 0.0;
+		SimulationParameters parameters = {};
+		parameters.S0 = X0;
+		parameters.r0 = r;
+		parameters.v0 = volatility * volatility;
+		parameters.T = T;
+		parameters.steps = steps;
+		parameters.sims = samples;
+
+		double* data[schemes];
+		double* metamean[schemes];
+		double* metastdev[schemes];
+
+		for (auto k = 0; k < schemes; k++) {
+			data[k] = arena.allocate<double>(samples);
+			metamean[k] = arena.allocate<double>(metasamples);
+			metastdev[k] = arena.allocate<double>(metasamples);
+		}
 
 		for (auto m = 0; m < metasamples; m++) {
 			//
@@ -36,113 +112,39 @@ int main(int argc, char *argv[]) {
 			//
 		
 			for (auto i = 0; i < samples; i++) {
-				XEM = X0;
-				XMilstein = X0;
-
-				for (auto j = 0; j < steps; j++) {
-					// Use the same random values for both the Milstein and Euler-Maruyama
-					dW = dist(gen) * sqrtdt;
-
-					// Euler-Maruyama
-					dx = (r * XEM * dt) + (volatility * XEM * dW);
-					XEM += dx;
-
-					// Milstein
-					dx = (r * XMilstein * dt) + (volatility * XMilstein * dW) + (0.5 * (volatility * XMilstein) * (volatility) * (dW * dW - dt));
-					XMilstein += dx;
-				}
-	
-				dataEM[i] = XEM;
-				dataMilstein[i] = XMilstein;
+				// Use the same random values for every scheme
+				uint64_t path = static_cast<uint64_t>(m) * samples + i;
+
+				data[0][i] = simulatePath<GBM, EulerMaruyama, AssetPrice, 0>(parameters, L, seed, path);
+				data[1][i] = simulatePath<GBM, Milstein, AssetPrice, 0>(parameters, L, seed, path);
+				data[2][i] = simulatePath<GBM, LogEuler, AssetPrice, 0>(parameters, L, seed, path);
 			}
 
 			//
 			// Calculate statistics
 			//
-	
-			double meanEM = 0.0, meanMilstein = 0.0;
-	
-			for (auto i = 0; i < samples; i++) {
-				meanEM += dataEM[i];
-				meanMilstein += dataMilstein[i];
-			}
-	
-			meanEM = meanEM / static_cast<double>(samples);
-			meanMilstein = meanMilstein / static_cast<double>(samples);
-
-			double stdevEM = 0.0, stdevMilstein = 0.0;
-
-			for (auto i = 0; i < samples; i++) {
-				stdevEM += pow(dataEM[i] - meanEM, 2.0);
-				stdevMilstein += pow(dataMilstein[i] - meanMilstein, 2.0);
-			}
-
-			stdevEM = sqrt(stdevEM / static_cast<double>(samples));
-			stdevMilstein = sqrt(stdevMilstein / static_cast<double>(samples));
-
-			metameanEM[m] = meanEM;
-			metastdevEM[m] = stdevEM;
-			metameanMilstein[m] = meanMilstein;
-			metastdevMilstein[m] = stdevMilstein;
-		}
 
-		double meanmean = 0.0, meanstdev = 0.0, stdevmean = 0.0, stdevstdev = 0.0;
+			for (auto k = 0; k < schemes; k++) {
+				double mean = 0.0, stdev = 0.0;
 
-		//
-		// Euler-Maruyama
-		//
-		
-		for (auto i = 0; i < metasamples; i++) {
-			meanmean += metameanEM[i];
-			stdevmean += metastdevEM[i];
-		}
-
-		meanmean = meanmean / static_cast<double>(metasamples);
-		stdevmean = stdevmean / static_cast<double>(metasamples);
+				for (auto i = 0; i < samples; i++)
+					mean += data[k][i];
 
-		for (auto i = 0; i < metasamples; i++) {
-			meanstdev += pow(metameanEM[i] - meanmean, 2.0);
-			stdevstdev += pow(metastdevEM[i] - stdevmean, 2.0);
-		}
+				mean = mean / static_cast<double>(samples);
 
-		meanstdev = sqrt(meanstdev / static_cast<double>(metasamples));
-		stdevstdev = sqrt(stdevstdev / static_cast<double>(metasamples));
+				for (auto i = 0; i < samples; i++)
+					stdev += pow(data[k][i] - mean, 2.0);
 
-		std::cout << "Euler-Maruyama : dt : " << dt << " : "
-			<< "MEAN : mean: " << meanmean << " : stdev: " << meanstdev << " : "
-			<< "STD DEV : mean: " << stdevmean << " : stdev: " << stdevstdev << std::endl;
-		
-		//
-		// Milstein
-		//
-
-		meanmean = 0.0;
-		meanstdev = 0.0;
-		stdevmean = 0.0;
-		stdevstdev = 0.0;
-
-		for (auto i = 0; i < metasamples; i++) {
-			meanmean += metameanMilstein[i];
-			stdevmean += metastdevMilstein[i];
-		}
-
-		meanmean = meanmean / static_cast<double>(metasamples);
-		stdevmean = stdevmean / static_cast<double>(metasamples);
-
-		for (auto i = 0; i < metasamples; i++) {
-			meanstdev += pow(metameanMilstein[i] - meanmean, 2.0);
-			stdevstdev += pow(metastdevMilstein[i] - stdevmean, 2.0);
+				metamean[k][m] = mean;
+				metastdev[k][m] = sqrt(stdev / static_cast<double>(samples));
+			}
 		}
 
-		meanstdev = sqrt(meanstdev / static_cast<double>(metasamples));
-		stdevstdev = sqrt(stdevstdev / static_cast<double>(metasamples));
+		for (auto k = 0; k < schemes; k++)
+			report(names[k], dt, metamean[k], metastdev[k], metasamples);
 
-		std::cout << "Milstein : dt : " << dt << " : "
-			<< "MEAN : mean: " << meanmean << " : stdev: " << meanstdev << " : "
-			<< "STD DEV : mean: " << stdevmean << " : stdev: " << stdevstdev << std::endl;
+		arena.reset();
 	}
 		
 	return 0;
 }
-
-
@@ -10,7 +10,11 @@
  * ----------  ------  ---------------
  * 2014-10-07  JJL     Initial version
  * 
+ * 2026-10-19  JJL     Log-Euler path on the same increments, exact
+ *                     for GBM and positive without clamping
  * 
+ * 2026-10-19  JJL     Logging through Log.h, -log=level and -quiet=1
+ *
  */
 
 //
@@ -18,13 +22,15 @@
 //
 
 #include "ReturnValues.h"
+#include "parseCommandLine.h"
+#include "Log.h"
 
 
 //
 // Standard includes
 //
 
-#include <iostream>
+#include <math.h>
 #include <random>
 
 
@@ -33,7 +39,8 @@
 //
 // Parameters:
 //    argc - Number of command line parameters
-//    argv[] - Command line parameters
+//    argv[] - Command line parameters, -log=level and -quiet=1 as
+//             in CPU-MC-EM
 //
 // Returns:
 //    Completion status
@@ -41,6 +48,14 @@
 
 int main(int argc, char* argv[]) {
 
+	auto arguments = parseCommandLine(argc, argv);
+
+	if (arguments.count("log") > 0)
+		logSetLevel(logParseLevel(arguments["log"]));
+
+	if ((arguments.count("quiet") > 0) && (arguments["quiet"] != "0"))
+		logSetLevel(_LOG_OFF_);
+
 	// Random number
 
 	std::default_random_engine generator;
@@ -64,28 +79,35 @@ int main(int argc, char* argv[]) {
 
 	double analytical = S0 * exp(r * T);
 
-	double sumS = 0.0;
+	double sumS = 0.0, sumLogS = 0.0;
 
 	auto samples = new double[numberSimulations];
 	
 	for (auto i = 0; i < numberSimulations; i++)
 		samples[i] = 0.0;
 
+	// Log-Euler steps ln S, d ln S = (r - sigma^2 / 2) dt + sigma dW
+	double logDrift = (r - 0.5 * sigma * sigma) * dt;
+
 
 	for (auto sim = 0; sim < numberSimulations; sim++) {
 		auto S = S0;
+		auto logS = log(S0);
 
 		for (auto step = 0; step < numberSteps; step++) {
 			auto dW = normal(generator) * sqrtdt;
 			auto dS = r * S * dt + sigma * S * dW;
 			S += dS;
+			logS += logDrift + sigma * dW;
 		}
 
 		sumS += S;
+		sumLogS += exp(logS);
 		samples[sim] = S;
 	}
 
 	auto ES = sumS / static_cast<double>(numberSimulations);
+	auto ESLog = sumLogS / static_cast<double>(numberSimulations);
 	double variance = 0.0;
 
 	for (auto i = 0; i < numberSimulations; i++)
@@ -93,11 +115,10 @@ int main(int argc, char* argv[]) {
 
 	variance = variance / static_cast<double>(numberSimulations - 1);
 
-	std::cout << "Simulation results:" << std::endl
-		<< "Analytical solution: " << analytical << std::endl
-		<< "Simulation: " << ES << std::endl
-		<< "Variance: " << variance << std::endl << std::endl
-		<< "Error: " << std::scientific << ES - analytical << std::endl;
+	LogLine(_LOG_INFO_, "Simulation results").field("analytical", analytical)
+		.field("mean", ES).field("variance", variance).field("error", ES - analytical);
+
+	LogLine(_LOG_INFO_, "Log-Euler results").field("mean", ESLog).field("error", ESLog - analytical);
 
 	return _OKAY_;
 }
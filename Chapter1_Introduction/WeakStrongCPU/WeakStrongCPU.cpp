@@ -3,6 +3,23 @@
  * Weak Error and Strong Error Estimation of European Put
  * Euler-Muryama Method with Monte Carlo
  *
+ * Log-Euler steps ln S with the Ito correction,
+ *
+ *    S' = S exp((r - v^2 / 2) dt + v dW)
+ *
+ * which is the exact solution of GBM at the grid points.  Both schemes
+ * take path p from the same stream, so the log-Euler path is the exact
+ * solution on the Brownian path that drives Euler-Maruyama, and
+ * E|S_EM - S_LE| is the strong error of Euler-Maruyama.  The weak
+ * error |E[S_N] - S0 exp(r T)| of log-Euler is zero at any step count,
+ * only its sampling error remains.
+ *
+ * With -richardson=k, k > 1, every step count N also reports
+ * sum_j w_j S_j over Euler-Maruyama paths with N, 2 N, ...,
+ * 2^(k-1) N steps on one Brownian path, the weights cancelling the
+ * first k - 1 terms of the weak error.  Its standard error comes from
+ * the extrapolated samples themselves.
+ *
  * See also
  * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
  * "On the implementation of multilevel Monte Carlo simulation
@@ -18,13 +35,24 @@
  * ----------  ------  ---------------
  * 2017-11-01  JJL     Initial version
  *
+ * 2026-10-19  JJL     Path loop replaced by the GBM kernel in
+ *                     Chapter4_Finance/Common/PathKernel.h
+ *
+ * 2026-10-19  JJL     Sweep of step counts comparing Euler-Maruyama
+ *                     with log-Euler on the same Brownian paths
+ *
+ * 2026-10-19  JJL     -richardson=k adds the Richardson-Romberg
+ *                     extrapolation of Euler-Maruyama over k coupled
+ *                     step refinements
+ *
+ * 2026-10-19  JJL     Logging through Log.h, -log=level and -quiet=1
+ *
  */
 
 //
 // Standard Includes
 //
 
-#include <iostream>
 #include <math.h>
 #include <random>
 
@@ -34,27 +62,66 @@
 //
 
 #include "ReturnValues.h"
+#include "PathKernel.h"
+#include "parseCommandLine.h"
+#include "Log.h"
+
+
+//
+// Definitions
+//
+
+#define _Max_Steps_   512
 
 
 //
 // Function: main()
 //
 // Parameters:
+//    -richardson=k - Step refinements of the extrapolated estimate,
+//                    1 (the default) for none
+//    -log=level - debug, info (the default), warn, error or off
+//    -quiet=1 - No output, for benchmark runs
 //
 // Returns:
+//    Completion status
+//
+// Comments:
+//    Doubles the steps from 1 to _Max_Steps_ and reports both schemes
+//    at every step count
 //
 
 int main(int argc, char* argv[]) {
 
+	auto arguments = parseCommandLine(argc, argv);
+
+	if (arguments.count("log") > 0)
+		logSetLevel(logParseLevel(arguments["log"]));
+
+	if ((arguments.count("quiet") > 0) && (arguments["quiet"] != "0"))
+		logSetLevel(_LOG_OFF_);
+
+	unsigned int richardson = 1;
+
+	if (arguments.count("richardson") > 0)
+		richardson = std::stoi(arguments["richardson"]);
+
+	if ((richardson == 0) || (richardson > _Richardson_Max_Refinements_)) {
+		LogLine(_LOG_ERROR_, "-richardson must be 1 to the largest refinement")
+			.field("largest", _Richardson_Max_Refinements_);
+		return _FAIL_;
+	}
+
+	double weights[_Richardson_Max_Refinements_];
+	richardsonWeights(richardson, weights);
+
 	// Random number
 
-	std::default_random_engine generator;
-	std::normal_distribution<double> normal(0, 1);
+	const uint64_t seed = 1;
 
 
 	// Monte Carlo Parameters
 
-	const unsigned int numberSteps = 500;
 	const unsigned int numberSamples = static_cast<unsigned int>(1E5);
 
 
@@ -67,48 +134,82 @@ int main(int argc, char* argv[]) {
 
 	const double analytical = S0 * exp(r * T);
 
-	double dt = T / static_cast<double>(numberSteps);
-	double sqrtdt = sqrt(dt);
+	SimulationParameters parameters = {};
+	parameters.S0 = S0;
+	parameters.r0 = r;
+	parameters.v0 = v * v;
+	parameters.T = T;
+	parameters.sims = numberSamples;
+
+	const std::array<std::array<double, 3>, 3> L = {{ {{ 1.0, 0.0, 0.0 }}, {{ 0.0, 1.0, 0.0 }}, {{ 0.0, 0.0, 1.0 }} }};
+
+	for (unsigned int numberSteps = 1; numberSteps <= _Max_Steps_; numberSteps *= 2) {
 
-	double S = 0.0, dS = 0.0, dW = 0.0;
+		double dt = T / static_cast<double>(numberSteps);
 
-	// Error variables
+		parameters.steps = numberSteps;
 
-	double sumS = 0.0, sumError = 0.0, sumS2 = 0.0;
+		// Error variables
 
-	// Perform simulation
+		double sumEM = 0.0, sumLE = 0.0, sumDifference = 0.0, sumDifference2 = 0.0, sumStrong = 0.0;
 
-	for (auto sample = 0; sample < numberSamples; sample++) {
+		// Perform simulation, both schemes on the same path
 
-		S = S0;
+		for (auto sample = 0u; sample < numberSamples; sample++) {
 
-		for (auto step = 0; step < numberSteps; step++) {
-			dW = normal(generator) * sqrtdt;
-			dS = r * S * dt + v * S * dW;
+			double SEM = simulatePath<GBM, EulerMaruyama, AssetPrice, 0>(parameters, L, seed, sample);
+			double SLE = simulatePath<GBM, LogEuler, AssetPrice, 0>(parameters, L, seed, sample);
 
-			S += dS;
+			sumEM += SEM;
+			sumLE += SLE;
+			sumDifference += SEM - SLE;
+			sumDifference2 += (SEM - SLE) * (SEM - SLE);
+			sumStrong += abs(SEM - SLE);
 		}
 
-		sumS += S;
-		sumS2 += S * S;
-		sumError += abs(S - analytical);
-	}
+		// Calculate results
+
+		double N = static_cast<double>(numberSamples);
+		double meanEM = sumEM / N;
+		double meanLE = sumLE / N;
+
+		// EM - LE has far less noise than either mean, it is the weak error of EM
+		double difference = sumDifference / N;
+		double differenceError = sqrt((sumDifference2 / N - difference * difference) / (N - 1.0));
+
+		// Display results
 
-	// Calculate results
+		LogLine(_LOG_INFO_, "Step count").field("steps", numberSteps).field("dt", dt)
+			.field("samples", N).field("analytical", analytical);
 
-	double mean = sumS / static_cast<double>(numberSamples);
-	double strongError = abs(mean - analytical);
-	double weakError = sumError / static_cast<double>(numberSamples);
+		LogLine(_LOG_INFO_, "Euler-Maruyama").field("mean", meanEM)
+			.field("weak", fabs(meanEM - analytical)).field("strong", sumStrong / N);
 
-	// Display results
+		LogLine(_LOG_INFO_, "Log-Euler").field("mean", meanLE)
+			.field("weak", fabs(meanLE - analytical));
 
-	std::cout << "Steps = " << std::fixed << numberSteps << std::endl
-	 	<< "dt = " << std::scientific << dt << std::endl
-		<< "Samples = " << std::scientific << numberSamples << std::endl
-		<< "E[S] = " << std::fixed << mean << std::endl
-		<< "Analytical = " << std::fixed << analytical << std::endl
-		<< "Strong error = " << std::scientific << strongError << std::endl
-		<< "Weak error = " << std::scientific << weakError << std::endl << std::endl;
+		LogLine(_LOG_INFO_, "E[S_EM - S_LE]").field("mean", difference).field("stderr", differenceError);
+
+		if (richardson == 1)
+			continue;
+
+		// Extrapolated Euler-Maruyama, N ... 2^(k-1) N steps on one path
+
+		double sumR = 0.0, sumR2 = 0.0;
+
+		for (auto sample = 0u; sample < numberSamples; sample++) {
+			double R = simulateRichardsonPath<GBM, EulerMaruyama, AssetPrice>(parameters, L, seed, sample, richardson, weights);
+
+			sumR += R;
+			sumR2 += R * R;
+		}
+
+		double meanR = sumR / N;
+		double errorR = sqrt((sumR2 / N - meanR * meanR) / (N - 1.0));
+
+		LogLine(_LOG_INFO_, "Richardson").field("k", richardson).field("mean", meanR)
+			.field("stderr", errorR).field("weak", fabs(meanR - analytical));
+	}
 
 	return _OKAY_;
 }
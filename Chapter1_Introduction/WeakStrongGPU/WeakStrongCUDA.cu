@@ -4,6 +4,16 @@
 // JJ Lay
 // January 2018
 //
+// 2026-10-19  Every step count runs Euler-Maruyama and log-Euler from
+//             the same random states.  Log-Euler steps ln S with the
+//             Ito correction, exact for GBM, so its weak error is
+//             sampling error only.
+//
+// 2026-10-19  -richardson=k combines the paths with pSteps, 2 pSteps,
+//             ..., 2^(k-1) pSteps steps on one Brownian path with the
+//             Richardson-Romberg weights.  Mean, variance and strong
+//             error are those of the combined sample.
+//
 
 // Sources:
 // https://docs.nvidia.com/cuda/curand/device-api-overview.html
@@ -26,6 +36,14 @@
 #include <string>
 #include <fstream>
 
+
+//
+// Local Includes
+//
+
+#include "../../Chapter4_Finance/Common/Log.h"
+#include "../../Chapter4_Finance/Common/parseCommandLine.h"
+
 //
 // Definitions
 //
@@ -33,6 +51,8 @@
 #define _OKAY_   0
 #define _CRASH_  1
 
+#define _Max_Richardson_  8
+
 
 //
 // Prototypes
@@ -41,8 +61,8 @@
 __global__ void WeakStrong(double *pSum, double *pSum2, double *pSamples,
 	double *pError, double *pVariance,
 	double pS0, double pK, double pr, double pv, double pT, double pActual,
-	unsigned int pSims, unsigned int pSteps, double pEpsilon,
-	curandState *pStates);
+	unsigned int pSims, unsigned int pSteps, double pEpsilon, bool pLogEuler,
+	unsigned int pRichardson, curandState *pStates);
 
 void Crash(std::string pFile, int pLine, cudaError_t pCUDAError, std::string pMessage);
 
@@ -63,6 +83,19 @@ int main(int argc, char *argv[])
 	int Threads = 100;
 	unsigned int Samples = 1 + TotalSimsDesired / Threads;
 
+	// Step refinements combined by Richardson-Romberg, 1 for none
+	auto Arguments = parseCommandLine(argc, argv);
+	unsigned int Richardson = 1;
+
+	if (Arguments.count("richardson") > 0) {
+		Richardson = std::stoi(Arguments["richardson"]);
+	}
+
+	if ((Richardson == 0) || (Richardson > _Max_Richardson_)) {
+		std::cerr << "-richardson must be 1 to " << _Max_Richardson_ << std::endl;
+		return _CRASH_;
+	}
+
 	//
 	// Finance Parameters
 	//
@@ -171,102 +204,107 @@ int main(int argc, char *argv[])
 	//
 
 	for (auto NumSteps = 1; NumSteps < 1000; NumSteps++) {
-		//
-		// Kernel Launch
-		//
-
-		WeakStrong << <1, Threads >> > (dev_Sum, dev_Sum2, dev_Samples, dev_Error, dev_Variance,
-			S0, K, r, v, T, Actual, Samples, NumSteps, Epsilon, dev_States);
-
-
-		// Check for any errors launching the kernel
-		cudaStatus = cudaGetLastError();
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "Kernel launch failed!");
-		}
-
-		// cudaDeviceSynchronize waits for the kernel to finish, and returns
-		// any errors encountered during the launch.
-		cudaStatus = cudaDeviceSynchronize();
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "cudaDeviceSynchronize failed!");
-		}
-
-
-		//
-		// Retrieve Results
-		//
-
-		// Copy output vector from GPU buffer to host memory.
-		cudaStatus = cudaMemcpy(host_Error, dev_Error, Threads * sizeof(double), cudaMemcpyDeviceToHost);
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "dev_Error Memcpy failed!");
-		}
-
-		cudaStatus = cudaMemcpy(host_Variance, dev_Variance, Threads * sizeof(double), cudaMemcpyDeviceToHost);
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "dev_Variance Memcpy failed!");
-		}
-
-		cudaStatus = cudaMemcpy(host_Sum, dev_Sum, Threads * sizeof(double), cudaMemcpyDeviceToHost);
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "dev_Sum Memcpy failed!");
-		}
-
-		cudaStatus = cudaMemcpy(host_Sum2, dev_Sum2, Threads * sizeof(double), cudaMemcpyDeviceToHost);
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "dev_Sum2 Memcpy failed!");
-		}
-
-		cudaStatus = cudaMemcpy(host_Samples, dev_Samples, Threads * sizeof(double), cudaMemcpyDeviceToHost);
-		if (cudaStatus != cudaSuccess) {
-			Crash(__FILE__, __LINE__, cudaStatus, "dev_Samples Memcpy failed!");
-		}
-
-
-		//
-		// Export Results
-		//
-
-
-		double FinalSum = 0.0;
-		double FinalSamples = 0.0;
-		double FinalSum2 = 0.0;
-		double FinalSumError = 0.0;
-		double FinalStdDev = 0.0;
-
-		for (auto i = 0; i < Threads; i++) {
-			FinalSum += host_Sum[i];
-			FinalSamples += host_Samples[i];
-			FinalSum2 += host_Sum2[i];
-			FinalSumError += host_Error[i];
-			FinalStdDev += host_Variance[i];
+		for (auto LogEuler : { false, true }) {
+			//
+			// Kernel Launch
+			//
+
+			WeakStrong << <1, Threads >> > (dev_Sum, dev_Sum2, dev_Samples, dev_Error, dev_Variance,
+				S0, K, r, v, T, Actual, Samples, NumSteps, Epsilon, LogEuler, Richardson, dev_States);
+
+
+			// Check for any errors launching the kernel
+			cudaStatus = cudaGetLastError();
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "Kernel launch failed!");
+			}
+
+			// cudaDeviceSynchronize waits for the kernel to finish, and returns
+			// any errors encountered during the launch.
+			cudaStatus = cudaDeviceSynchronize();
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "cudaDeviceSynchronize failed!");
+			}
+
+
+			//
+			// Retrieve Results
+			//
+
+			// Copy output vector from GPU buffer to host memory.
+			cudaStatus = cudaMemcpy(host_Error, dev_Error, Threads * sizeof(double), cudaMemcpyDeviceToHost);
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "dev_Error Memcpy failed!");
+			}
+
+			cudaStatus = cudaMemcpy(host_Variance, dev_Variance, Threads * sizeof(double), cudaMemcpyDeviceToHost);
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "dev_Variance Memcpy failed!");
+			}
+
+			cudaStatus = cudaMemcpy(host_Sum, dev_Sum, Threads * sizeof(double), cudaMemcpyDeviceToHost);
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "dev_Sum Memcpy failed!");
+			}
+
+			cudaStatus = cudaMemcpy(host_Sum2, dev_Sum2, Threads * sizeof(double), cudaMemcpyDeviceToHost);
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "dev_Sum2 Memcpy failed!");
+			}
+
+			cudaStatus = cudaMemcpy(host_Samples, dev_Samples, Threads * sizeof(double), cudaMemcpyDeviceToHost);
+			if (cudaStatus != cudaSuccess) {
+				Crash(__FILE__, __LINE__, cudaStatus, "dev_Samples Memcpy failed!");
+			}
+
+
+			//
+			// Export Results
+			//
+
+
+			double FinalSum = 0.0;
+			double FinalSamples = 0.0;
+			double FinalSum2 = 0.0;
+			double FinalSumError = 0.0;
+			double FinalStdDev = 0.0;
+
+			for (auto i = 0; i < Threads; i++) {
+				FinalSum += host_Sum[i];
+				FinalSamples += host_Samples[i];
+				FinalSum2 += host_Sum2[i];
+				FinalSumError += host_Error[i];
+				FinalStdDev += host_Variance[i];
+			}
+
+			double FinalMean = FinalSum / FinalSamples;
+			double FinalError = FinalMean - Actual;
+			double FinalVariance = (FinalSum2 / FinalSamples) - (FinalMean * FinalMean);
+			double FinalSumErrorMean = FinalSumError / FinalSamples;
+			FinalStdDev = sqrt(FinalStdDev / FinalSamples);
+
+			double dt = T / static_cast<double>(NumSteps);
+
+
+			LogLine(_LOG_INFO_, "WeakStrong")
+				.field("scheme", LogEuler ? "logeuler" : "em")
+				.field("richardson", Richardson)
+				.field("analytical", Actual)
+				.field("mean", FinalMean)
+				.field("weak", FinalError)
+				.field("strong", FinalSumErrorMean)
+				.field("dt", dt)
+				.field("stddev", FinalStdDev);
+
+			LogFile << "Scheme: " << (LogEuler ? "log-Euler" : "Euler-Maruyama") << ", "
+				<< "Richardson: " << Richardson << ", "
+				<< "Analytical: " << Actual << ", "
+				<< "Final Mean: " << FinalMean << ", "
+				<< "Final Weak Error: " << std::fixed << std::setprecision(6) << FinalError << ", "
+				<< "Final Strong Error: " << FinalSumErrorMean << ", "
+				<< "dt: " << dt << ", "
+				<< "StdDev: " << FinalStdDev << "\n";
 		}
-
-		double FinalMean = FinalSum / FinalSamples;
-		double FinalError = FinalMean - Actual;
-		double FinalVariance = (FinalSum2 / FinalSamples) - (FinalMean * FinalMean);
-		double FinalSumErrorMean = FinalSumError / FinalSamples;
-		FinalStdDev = sqrt(FinalStdDev / FinalSamples);
-
-		double dt = T / static_cast<double>(NumSteps);
-
-
-		std::cout << "Analytical: " << Actual << ", "
-			<< "Final Mean: " << FinalMean << ", "
-			<< "Final Weak Error: " << std::fixed << std::setprecision(6) << FinalError << ", "
-			<< "Final Strong Error: " << FinalSumErrorMean << ", "
-			<< "dt: " << dt << ", "
-			<< "StdDev: " << FinalStdDev << std::endl;
-
-		LogFile << "Analytical: " << Actual << ", "
-			<< "Final Mean: " << FinalMean << ", "
-			<< "Final Weak Error: " << std::fixed << std::setprecision(6) << FinalError << ", "
-			<< "Final Strong Error: " << FinalSumErrorMean << ", "
-			<< "dt: " << dt << ", "
-			<< "StdDev: " << FinalStdDev << std::endl;
-
-		LogFile.flush();
 	}
 
 	LogFile.close();
@@ -303,16 +341,36 @@ int main(int argc, char *argv[])
 __global__ void WeakStrong(double *pSum, double *pSum2, double *pSamples, 
 	double *pError, double *pVariance,
 	double pS0, double pK, double pr, double pv, double pT, double pActual,
-	unsigned int pSims, unsigned int pSteps, double pEpsilon,
-	curandState *pStates)
+	unsigned int pSims, unsigned int pSteps, double pEpsilon, bool pLogEuler,
+	unsigned int pRichardson, curandState *pStates)
 {
 	int idx = threadIdx.x;
 
 	curand_init(31415, idx, 0, &pStates[idx]);
 
-	double dt = pT / static_cast<double>(pSteps);
+	//
+	// Path j takes pSteps * 2^j steps, each one the sum of 2^(k-1-j)
+	// steps of the finest path.  Weight w_j = prod_(i != j) 1 / (1 - 2^(i-j))
+	// cancels the dt, ..., dt^(k-1) terms of the weak error.
+	//
+
+	unsigned int Finest = pSteps << (pRichardson - 1);
+
+	double dt = pT / static_cast<double>(Finest);
 	double Sqrtdt = sqrt(dt);
 
+	double Weight[_Max_Richardson_];
+
+	for (unsigned int j = 0; j < pRichardson; j++) {
+		Weight[j] = 1.0;
+
+		for (unsigned int i = 0; i < pRichardson; i++) {
+			if (i != j) {
+				Weight[j] /= 1.0 - ldexp(1.0, static_cast<int>(i) - static_cast<int>(j));
+			}
+		}
+	}
+
 	//
 	// Aggregate Variables
 	//
@@ -341,13 +399,44 @@ __global__ void WeakStrong(double *pSum, double *pSum2, double *pSamples,
 	double WM = 0.0, WS = 0.0, WX = 0.0, WMOld = 0.0;  
 
 	for (unsigned int i = 0; i < pSims; i++) {
-		double Result = 0.0;
-		double S = pS0;
+		double Path[_Max_Richardson_];
+		double PathdW[_Max_Richardson_];
 
-		for (unsigned int s = 0; s < pSteps; s++) {
+		for (unsigned int j = 0; j < pRichardson; j++) {
+			Path[j] = pS0;
+			PathdW[j] = 0.0;
+		}
+
+		for (unsigned int s = 0; s < Finest; s++) {
 			double dW = Sqrtdt * curand_normal(&pStates[idx]);
-			double dS = (pr * S * dt) + (pv * S * dW);
-			S += dS;
+
+			for (unsigned int j = 0; j < pRichardson; j++) {
+				unsigned int Stride = 1u << (pRichardson - 1 - j);
+
+				PathdW[j] += dW;
+
+				if ((s + 1) % Stride != 0) {
+					continue;
+				}
+
+				double h = dt * static_cast<double>(Stride);
+
+				if (pLogEuler) {
+					Path[j] *= exp((pr - 0.5 * pv * pv) * h + pv * PathdW[j]);
+				}
+				else {
+					double dS = (pr * Path[j] * h) + (pv * Path[j] * PathdW[j]);
+					Path[j] += dS;
+				}
+
+				PathdW[j] = 0.0;
+			}
+		}
+
+		double S = 0.0;
+
+		for (unsigned int j = 0; j < pRichardson; j++) {
+			S += Weight[j] * Path[j];
 		}
 
 		WX = S;
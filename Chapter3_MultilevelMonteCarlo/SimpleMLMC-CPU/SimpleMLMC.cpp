@@ -2,6 +2,14 @@
  * Simple Multilevel Monte Carlo
  * Single Threaded CPU Version
  *
+ * Estimates E[S(T)] of geometric Brownian motion with Euler-Maruyama.
+ * Level l takes 2^l steps and its coarse path steps with the sum of
+ * each pair of fine increments.  The number of samples per level and
+ * the number of levels are chosen by the driver in MLMC.h to reach
+ * the root mean square error given on the command line.
+ *
+ * Usage: SimpleMLMC [eps]
+ *
  * JJ Lay
  * Middle Tennessee State University
  * October 2014
@@ -9,8 +17,16 @@
  * DATE        AUTHOR  COMMENTS
  * ----------  ------  ---------------
  * 2014-10-07  JJL     Initial version
- * 
- * 
+ *
+ * 2026-10-19  JJL     Runs on the generic MLMC driver, samples per
+ *                     level from the variance and cost of each
+ *                     level instead of a fixed 10,000
+ *
+ * 2026-10-19  JJL     Prints the level table of diagnoseLevels()
+ *
+ * 2026-10-19  JJL     Normal distribution made per path so no path
+ *                     draws from the cached variate of the one before
+ *
  */
 
 
@@ -19,14 +35,19 @@
 //
 
 #include "ReturnValues.h"
+#include "../../Chapter4_Finance/Common/MLMC.h"
+#include "../../Chapter4_Finance/Common/PathRandom.h"
 
 
 //
 // Standard includes
 //
 
+#include <iomanip>
 #include <iostream>
+#include <math.h>
 #include <random>
+#include <string>
 
 
 //
@@ -42,18 +63,12 @@
 
 int main(int argc, char* argv[]) {
 
-	// Random number
-
-	std::default_random_engine generator;
-	std::normal_distribution<double> normal(0, 1);
-
-
 	// Monte Carlo Parameters
 
-	const int initialLevel = 0;
-	const int numberLevels = 5;
-	const int stopLevel = initialLevel + numberLevels - 1;
-	const int initialSimulations = 10000;
+	const uint64_t seed = 1;
+
+	MLMCOptions options;
+	options.eps = (argc > 1 ? std::stod(argv[1]) : 0.01);
 
 	// Black-Scholes parameters
 
@@ -64,85 +79,102 @@ int main(int argc, char* argv[]) {
 
 	double analytical = S0 * exp(r * T);
 
-	auto samples = new unsigned int[numberLevels];
-	auto results = new double[numberLevels];
-	auto variance = new double[numberLevels];
-
-	for (auto level = 0; level < numberLevels; level++) {
-		samples[level] = initialSimulations;
-		results[level] = 0.0;
-		variance[level] = 0.0;
-	}
-
-	unsigned int m = 0;
-
 	//
-	// Perform the simulation of each multilevel Monte Carlo level
+	// Fine minus coarse samples of one level
 	//
 
-	for (auto level = initialLevel+1; level <= stopLevel; level++) {
-		int numberStepsf = pow(2, level);
+	auto level = [&](unsigned int plevel, uint64_t pfirst, uint64_t pcount) {
+		auto sums = emptyLevel();
+
+		int numberStepsf = 1 << plevel;
 		double dtf = T / static_cast<double>(numberStepsf);
 		double sqrtdtf = sqrt(dtf);
+		double dtc = 2.0 * dtf;
 
-		int numberStepsc = pow(2, level - 1);
-		double dtc = T / static_cast<double>(numberStepsc);
-		double sqrtdtc = sqrt(dtc);
-
+		for (auto sim = pfirst; sim < pfirst + pcount; sim++) {
+			// A fresh distribution per path, it caches the second normal of each pair
+			PathGenerator generator(levelSeed(seed, plevel), sim);
+			std::normal_distribution<double> normal(0, 1);
 
-		//
-		// Perform the simulations
-		//
-
-		for (auto sim = 0; sim < initialSimulations; sim++) {
 			auto Sf = S0;
 			auto Sc = S0;
 
+			if (plevel == 0) {
+				Sf += r * Sf * dtf + sigma * Sf * normal(generator) * sqrtdtf;
+				accumulateLevel(&sums, Sf, 0.0);
+				continue;
+			}
+
 			//
 			// Step through time
 			//
 
-			for (auto step = 0; step < numberStepsf; step++) {
+			for (auto step = 0; step < numberStepsf; step += 2) {
 				auto dWf1 = normal(generator) * sqrtdtf;
 				auto dWf2 = normal(generator) * sqrtdtf;
 				auto dWc = dWf1 + dWf2;
 
-				// Fine 
-				auto dSf = r * Sf * dtf + sigma * Sf * dWf1;
-				Sf += dSf;
-				dSf = r * Sf * dtf + sigma * Sf * dWf2;
-				Sf += dSf;
+				// Fine
+				Sf += r * Sf * dtf + sigma * Sf * dWf1;
+				Sf += r * Sf * dtf + sigma * Sf * dWf2;
 
 				// Coarse
-				auto dSc = r * Sc * dtc + sigma * Sc * dWc;
-				Sc += dSc;
+				Sc += r * Sc * dtc + sigma * Sc * dWc;
 			}
 
-			results[m] += Sf - Sc;
+			accumulateLevel(&sums, Sf, Sc);
 		}
 
-		results[m] = results[m] / static_cast<double>(samples[level]);
-		variance[m] = 0.0;
+		// Cost in time steps, fine plus coarse
+		sums.cost = static_cast<double>(pcount) * (plevel == 0 ? 1.0 : 1.5 * numberStepsf);
 
-		m++;
-	}
+		return sums;
+	};
 
+	auto result = multilevelMonteCarlo(level, options);
 
 
 	std::cout << "Simulation results:" << std::endl
-		<< "Analytical solution: " << analytical << std::endl
-		<< "Simulation results:" << std::endl;
+		<< "Analytical solution: " << analytical << std::endl;
+
+	//
+	// Level table, consistency above 1 or a kurtosis in the hundreds
+	// means the level cannot be trusted
+	//
+
+	auto diagnostics = diagnoseLevels(result.levels);
+	auto precision = std::cout.precision(4);
 
-	for (auto level = 0; level < numberLevels; level++) {
-		std::cout << "   Level[" << initialLevel + level << "] = " << results[level] << std::endl;
+	std::cout << std::setw(3) << "l" << std::setw(11) << "N"
+		<< std::setw(13) << "E[Pf-Pc]" << std::setw(13) << "V[Pf-Pc]"
+		<< std::setw(13) << "E[Pf]" << std::setw(13) << "V[Pf]"
+		<< std::setw(11) << "us/sample" << std::setw(10) << "kurtosis"
+		<< std::setw(9) << "check" << std::endl;
+
+	for (size_t l = 0; l < diagnostics.levels.size(); l++) {
+		auto& row = diagnostics.levels[l];
+
+		std::cout << std::setw(3) << l << std::setw(11) << row.samples
+			<< std::setw(13) << row.mean << std::setw(13) << row.variance
+			<< std::setw(13) << row.meanFine << std::setw(13) << row.varianceFine
+			<< std::setw(11) << 1e6 * row.seconds << std::setw(10) << row.kurtosis
+			<< std::setw(9) << row.consistency << std::endl;
 	}
 
-/*
-		<< "Simulation: " << ES << std::endl
-		<< "Variance: " << variance << std::endl << std::endl
-		<< "Error: " << std::scientific << ES - analytical << std::endl;
-*/
+	std::cout << "alpha = " << diagnostics.alpha << "  beta = " << diagnostics.beta
+		<< "  gamma = " << diagnostics.gamma << "  gamma (time) = " << diagnostics.gammaSeconds
+		<< std::endl;
+
+	std::cout.precision(precision);
+
+	std::cout << "Simulation: " << result.estimate << std::endl
+		<< "Standard error: " << sqrt(result.variance) << std::endl
+		<< "Target RMSE: " << options.eps << std::endl
+		<< "Cost: " << result.cost << std::endl
+		<< "Error: " << std::scientific << result.estimate - analytical << std::endl;
+
+	if (!result.converged)
+		std::cout << "Warning: bias above target at the finest level" << std::endl;
 
 	return _OKAY_;
 }
-
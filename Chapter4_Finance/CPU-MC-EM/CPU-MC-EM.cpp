@@ -27,6 +27,69 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Added -shard=i/n, -seed and -partial for
+ *                     splitting one pricing across batch jobs
+ *
+ * 2026-10-19  JJL     Added -model, -scheme, -payoff and the
+ *                     -rho12, -rho13, -rho23 correlations
+ *
+ * 2026-10-19  JJL     Added -parameters, -results and -watch to
+ *                     price a parameter file incrementally
+ *
+ * 2026-10-19  JJL     Output through the asynchronous logger,
+ *                     -log=level and -quiet=1
+ *
+ * 2026-10-19  JJL     Added -store and -set to append results
+ *                     to a columnar result file
+ *
+ * 2026-10-19  JJL     Added -pipeline and -depth for a streaming
+ *                     read, simulate and write sweep
+ *
+ * 2026-10-19  JJL     Added -mlmc=eps and -levels for a multilevel
+ *                     estimate to a target RMSE
+ *
+ * 2026-10-19  JJL     Added -antithetic.  The defaults may be set at
+ *                     build time, which gives the CPU-AMLMC-EM and
+ *                     CPU-AMLMC-MIL targets
+ *
+ * 2026-10-19  JJL     Added -threads for the multilevel estimate
+ *
+ * 2026-10-19  JJL     Added -mimc=eps for a multi-index estimate of
+ *                     HHW, refining the asset steps and the v, r
+ *                     sub-steps separately
+ *
+ * 2026-10-19  JJL     Added -mlqmc=eps, multilevel quasi-Monte Carlo
+ *                     on randomized Sobol points
+ *
+ * 2026-10-19  JJL     Level table moved to MonteCarlo.cpp
+ *
+ * 2026-10-19  JJL     Added -continuation=stages, logging the answer
+ *                     of every stage as the tolerance tightens to
+ *                     -mlmc
+ *
+ * 2026-10-19  JJL     Added -singleterm=eps, the randomized single
+ *                     term estimator that draws a level per sample
+ *
+ * 2026-10-19  JJL     Added -adaptive for path dependent time steps
+ *                     in -mlmc and -singleterm
+ *
+ * 2026-10-19  JJL     Added -convergence=n, the weak error of -scheme
+ *                     and of additive Euler-Maruyama over n doublings
+ *                     of -steps
+ *
+ * 2026-10-19  JJL     Added -richardson=k, Richardson-Romberg
+ *                     extrapolation over k coupled step refinements
+ *
+ * 2026-10-19  JJL     -mimc runs its split direction as nested and
+ *                     fits the time rate
+ *
+ * 2026-10-19  JJL     -mimc removed, its nested split direction only
+ *                     repeated -mlmc along time at a higher cost
+ *
+ * 2026-10-19  JJL     -continuation rejected without -mlmc
+ *
+ * 2026-10-19  JJL     -singleterm takes -levels and -antithetic
+ *
  */
 
 
@@ -36,15 +99,223 @@
 
 #include "parseCommandLine.h"
 #include "ReturnValues.h"
+#include "Crash.h"
+#include "Log.h"
+#include "createMatrix.h"
+#include "Simulation.h"
 #include "MonteCarlo.h"
+#include "Sweep.h"
+#include "Pipeline.h"
 
 
 //
 // Standard includes
 //
 
-#include <iostream>
 #include <chrono>
+#include <cstdint>
+#include <math.h>
+#include <string>
+#include <vector>
+
+
+//
+// Build time defaults, see the Makefile targets
+//
+
+#ifndef _Default_Scheme_
+#define _Default_Scheme_       "em"
+#endif
+
+#ifndef _Default_MLMC_
+#define _Default_MLMC_         0.0
+#endif
+
+#ifndef _Default_Antithetic_
+#define _Default_Antithetic_   false
+#endif
+
+
+//
+// Function: runMultilevel()
+//
+// Parameters:
+//    psimulation - Model parameters, steps is the number of steps on level 0
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    peps - Target root mean square error
+//    plevels - Maximum number of levels, 0 for the driver's default
+//    pantithetic - Antithetic level estimator
+//    padaptive - Path dependent time steps
+//    pthreads - Threads sampling the levels, 0 for one per core
+//    pstages - Continuation stages, 1 for a single run at peps
+//    pquasi - Randomized Sobol points instead of random paths
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+static int runMultilevel(SimulationParameters psimulation, std::string pmodel,
+    std::string pscheme, std::string ppayoff, uint64_t pseed, double peps, unsigned int plevels,
+    bool pantithetic, bool padaptive, unsigned int pthreads, unsigned int pstages, bool pquasi = false) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    MLMCOptions options;
+    options.eps = peps;
+    options.threads = pthreads;
+    options.stages = pstages;
+
+    if (plevels > 0)
+        options.maxLevels = plevels;
+
+    if (pquasi && pantithetic)
+        crash(__LINE__, __FILE__, __FUNCTION__, "-mlqmc has no antithetic estimator");
+
+    // Answers as the tolerance tightens, the last stage is the result below
+    options.stage = [&](unsigned int pstage, double pstageEps, const MLMCResult& presult) {
+        if (pstages > 1)
+            LogLine(_LOG_INFO_, "Continuation stage").field("stage", static_cast<uint64_t>(pstage))
+                .field("eps", pstageEps).field("mean", presult.estimate)
+                .field("stderr", sqrt(presult.variance)).field("cost", presult.cost)
+                .field("levels", static_cast<uint64_t>(presult.levels.size()))
+                .field("ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    };
+
+    auto result = (pquasi
+        ? MultilevelQuasiMonteCarlo(psimulation, pmodel, pscheme, ppayoff, pseed, options)
+        : MultilevelMonteCarlo(psimulation, pmodel, pscheme, ppayoff, pseed, options, pantithetic, padaptive));
+
+    LogLine(_LOG_INFO_, "Multilevel results")
+        .field("mean", result.estimate).field("stderr", sqrt(result.variance))
+        .field("eps", peps).field("antithetic", pantithetic ? "yes" : "no")
+        .field("adaptive", padaptive ? "yes" : "no")
+        .field("quasi", pquasi ? "yes" : "no").field("cost", result.cost)
+        .field("alpha", result.alpha).field("beta", result.beta).field("gamma", result.gamma)
+        .field("ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    if (psimulation.actual != 0.0)
+        LogLine(_LOG_INFO_, "Errors").field("strong", result.estimate - psimulation.actual);
+
+    return _OKAY_;
+}
+
+
+//
+// Function: runSingleTerm()
+//
+// Parameters:
+//    psimulation - Model parameters, steps is the number of steps on level 0
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    peps - Target standard error
+//    plevels - Levels that can be drawn, 0 for the driver's default
+//    pantithetic - Antithetic level estimator
+//    padaptive - Path dependent time steps
+//    pthreads - Threads sampling the blocks, 0 for one per core
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+static int runSingleTerm(SimulationParameters psimulation, std::string pmodel,
+    std::string pscheme, std::string ppayoff, uint64_t pseed, double peps, unsigned int plevels,
+    bool pantithetic, bool padaptive, unsigned int pthreads) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    SingleTermOptions options;
+    options.eps = peps;
+    options.threads = pthreads;
+
+    if (plevels > 0)
+        options.maxLevel = plevels - 1;
+
+    auto result = SingleTermMonteCarlo(psimulation, pmodel, pscheme, ppayoff, pseed, options,
+        pantithetic, padaptive);
+
+    // The estimate is unbiased, so its standard error is the RMSE
+    LogLine(_LOG_INFO_, "Single term results")
+        .field("mean", result.estimate).field("stderr", sqrt(result.variance))
+        .field("ci95", 1.96 * sqrt(result.variance)).field("eps", peps)
+        .field("antithetic", pantithetic ? "yes" : "no")
+        .field("samples", result.samples).field("cost", result.cost)
+        .field("beta", result.beta).field("gamma", result.gamma)
+        .field("ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    if (psimulation.actual != 0.0)
+        LogLine(_LOG_INFO_, "Errors").field("strong", result.estimate - psimulation.actual);
+
+    return _OKAY_;
+}
+
+
+//
+// Function: runConvergence()
+//
+// Parameters:
+//    psimulation - Model parameters, steps is the coarsest step count
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    pcounts - Number of step counts, steps, 2 steps, ...
+//    prichardson - Step refinements of every estimate, 1 for none
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+// Comments:
+//    Prices with pscheme and with em at every step count.  Both draw
+//    path p from the same stream at a given step count, so their
+//    difference is much better resolved than either price.  The error
+//    is against -actual, or without one against pscheme at the finest
+//    step count, which then reads 0.
+//
+
+static int runConvergence(SimulationParameters psimulation, std::string pmodel,
+    std::string pscheme, std::string ppayoff, uint64_t pseed, unsigned int pcounts,
+    unsigned int prichardson) {
+
+    if ((pcounts == 0) || (psimulation.steps == 0))
+        crash(__LINE__, __FILE__, __FUNCTION__, "-convergence needs at least one step count and -steps");
+
+    std::vector<std::string> schemes = { pscheme };
+
+    if (pscheme != "em")
+        schemes.push_back("em");
+
+    // <Mean, Variance, Samples, ...> by step count, then scheme
+    std::vector<std::vector<std::tuple<double, double, double, double, double>>> results(pcounts);
+
+    auto steps = psimulation.steps;
+
+    for (unsigned int c = 0; c < pcounts; c++) {
+        psimulation.steps = steps << c;
+
+        for (auto& scheme : schemes)
+            results[c].push_back(MonteCarlo(psimulation, pmodel, scheme, ppayoff, 0, 1, pseed, "", prichardson));
+    }
+
+    double reference = (psimulation.actual != 0.0 ? psimulation.actual
+        : std::get<_Tuple_Mean_>(results[pcounts - 1][0]));
+
+    LogLine(_LOG_INFO_, "Convergence reference").field("value", reference)
+        .field("source", psimulation.actual != 0.0 ? "actual" : pscheme.c_str());
+
+    for (unsigned int c = 0; c < pcounts; c++) {
+        for (size_t k = 0; k < schemes.size(); k++) {
+            auto& result = results[c][k];
+            double mean = std::get<_Tuple_Mean_>(result);
+
+            LogLine(_LOG_INFO_, "Weak error")
+                .field("steps", steps << c).field("scheme", schemes[k]).field("richardson", prichardson)
+                .field("mean", mean)
+                .field("stderr", sqrt(std::get<_Tuple_Variance_>(result) / std::get<_Tuple_Samples_>(result)))
+                .field("error", mean - reference);
+        }
+    }
+
+    return _OKAY_;
+}
 
 
 //
@@ -69,10 +340,53 @@ int main(int argc, char* argv[]) {
         vbar = 0.0, rbar = 0.0, actual = 0.0;
     unsigned int steps = 0, sims = 0;
 
-	auto rho = new double[9];
-	
-	memset(rho, 0.0, 9);
-	rho[0] = 1.0; rho[4] = 1.0; rho[8] = 1.0;
+    // Sharding
+    unsigned int shard = 0, shards = 1;
+    uint64_t seed = 1;
+    std::string partialFile = "";
+
+    // Kernel selection
+    std::string model = "hhw", scheme = _Default_Scheme_, payoff = "put";
+
+    // Correlations of (S, v), (S, r) and (v, r)
+    double rho12 = 0.0, rho13 = 0.0, rho23 = 0.0;
+
+    // Parameter file sweep
+    std::string parametersFile = "", resultsFile = "";
+    bool watch = false;
+
+    // Pipelined sweep, simulation threads (0 for one per core) and queue depth
+    bool pipeline = false;
+    unsigned int workers = 0, depth = _Pipeline_Depth_;
+
+    // Multilevel Monte Carlo, target RMSE (0 for plain Monte Carlo) and
+    // maximum levels (0 for the driver's default)
+    double mlmc = _Default_MLMC_;
+    unsigned int levels = 0;
+    bool antithetic = _Default_Antithetic_;
+    unsigned int threads = 0;
+
+    // Multilevel quasi-Monte Carlo, target RMSE (0 for none)
+    double mlqmc = 0.0;
+
+    // Continuation stages of the multilevel estimate
+    unsigned int stages = 1;
+
+    // Randomized single term estimate, target standard error (0 for none)
+    double singleTerm = 0.0;
+
+    // Path dependent time steps for the level estimators
+    bool adaptive = false;
+
+    // Weak error study over this many doublings of -steps (0 for none)
+    unsigned int convergence = 0;
+
+    // Richardson-Romberg step refinements of plain Monte Carlo (1 for none)
+    unsigned int richardson = 1;
+
+    // Columnar result file and the id this pricing is stored under
+    std::string storeFile = "";
+    uint64_t parameterSet = 0;
 
     //
     // Process commandline parameters
@@ -80,12 +394,19 @@ int main(int argc, char* argv[]) {
 
     auto parameters = parseCommandLine(argc, argv);
 
+    // Log level first, so the remaining parameters are logged correctly
+    if (parameters.count("log") > 0)
+        logSetLevel(logParseLevel(parameters["log"]));
+
+    // Suppress all output, for benchmark runs
+    if ((parameters.count("quiet") > 0) && (parameters["quiet"] != "0"))
+        logSetLevel(_LOG_OFF_);
+
     for (auto p : parameters) {
         auto key = p.first;
         auto value = p.second;
 
-        std::cout << "Key: " << key << " :: " << "Value: " 
-		<< value << std::endl;
+        LogLine(_LOG_DEBUG_, "Parameter").field("key", key).field("value", value);
 
         // Initial asset price
         if (key == "S0")
@@ -137,68 +458,222 @@ int main(int argc, char* argv[]) {
         if (key == "sims")
             sims = std::stoi(value);
 
-        // Number of simulations
+        // Closed form solution
         if (key == "actual")
             actual = std::stod(value);
+
+        // Shard of a split pricing, given as i/n with 0 <= i < n
+        if (key == "shard") {
+            auto slash = value.find("/");
+
+            if (slash == std::string::npos)
+                crash(__LINE__, __FILE__, __FUNCTION__, "Expected -shard=i/n, found " + value);
+
+            shard = std::stoi(value.substr(0, slash));
+            shards = std::stoi(value.substr(slash + 1));
+        }
+
+        // Seed shared by all shards of a pricing
+        if (key == "seed")
+            seed = std::stoull(value);
+
+        // Partial result file for MergePartials
+        if (key == "partial")
+            partialFile = value;
+
+        // Model: gbm, heston or hhw
+        if (key == "model")
+            model = value;
+
+        // Discretization: em, milstein, logeuler, qe or exact
+        if (key == "scheme")
+            scheme = value;
+
+        // Payoff: put, call or asset
+        if (key == "payoff")
+            payoff = value;
+
+        if (key == "rho12")
+            rho12 = std::stod(value);
+
+        if (key == "rho13")
+            rho13 = std::stod(value);
+
+        if (key == "rho23")
+            rho23 = std::stod(value);
+
+        // Price every row of a parameter file such as ../Common/parameters.csv
+        if (key == "parameters")
+            parametersFile = value;
+
+        // Results table of the parameter file sweep
+        if (key == "results")
+            resultsFile = value;
+
+        // Re-price changed rows whenever the parameter file changes
+        if (key == "watch")
+            watch = (value != "0");
+
+        // Append the results to a columnar result file, see ResultsToCSV
+        if (key == "store")
+            storeFile = value;
+
+        if (key == "set")
+            parameterSet = std::stoull(value);
+
+        // Stream the parameter file through reader, simulation and writer stages
+        if (key == "pipeline") {
+            pipeline = true;
+            workers = std::stoi(value);
+        }
+
+        if (key == "depth")
+            depth = std::stoi(value);
+
+        // Multilevel estimate to this root mean square error, -steps is level 0
+        if (key == "mlmc")
+            mlmc = std::stod(value);
+
+        if (key == "levels")
+            levels = std::stoi(value);
+
+        // Antithetic multilevel estimator, fine paths paired with their swapped twin
+        if (key == "antithetic")
+            antithetic = (value != "0");
+
+        // Threads sampling the levels, 0 for one per core
+        if (key == "threads")
+            threads = std::stoi(value);
+
+        // Multilevel estimate on randomized Sobol points, -levels and -threads apply
+        if (key == "mlqmc")
+            mlqmc = std::stod(value);
+
+        // Solve -mlmc at tolerances 2^(stages-1) eps, ..., 2 eps, eps reusing the samples
+        if (key == "continuation")
+            stages = std::stoi(value);
+
+        // Unbiased estimate, each sample one level drawn at random, -levels, -antithetic and -threads apply
+        if (key == "singleterm")
+            singleTerm = std::stod(value);
+
+        // Refine the steps of a path as v or r nears zero, -steps is the coarsest step
+        if (key == "adaptive")
+            adaptive = (value != "0");
+
+        // Weak error of -scheme and em at -steps, 2 -steps, ... on the same paths
+        if (key == "convergence")
+            convergence = std::stoi(value);
+
+        // Extrapolate coupled paths with -steps, 2 -steps, ..., 2^(k-1) -steps to zero step
+        if (key == "richardson")
+            richardson = std::stoi(value);
+    }
+
+    SimulationParameters simulation;
+
+    simulation.S0 = S0;
+    simulation.v0 = v0;
+    simulation.r0 = r0;
+    simulation.T = T;
+    simulation.K = K;
+    simulation.Kv = Kv;
+    simulation.Kr = Kr;
+    simulation.sigmav = sigmav;
+    simulation.sigmar = sigmar;
+    simulation.vbar = vbar;
+    simulation.rbar = rbar;
+    simulation.actual = actual;
+    simulation.steps = steps;
+    simulation.sims = sims;
+    simulation.rho = createMatrix(rho12, rho13, rho23);
+
+    if (adaptive && (((mlmc <= 0.0) && (singleTerm <= 0.0)) || (mlqmc > 0.0)
+        || (parametersFile.length() > 0)))
+        crash(__LINE__, __FILE__, __FUNCTION__, "-adaptive applies to -mlmc and -singleterm only");
+
+    if ((richardson != 1) && ((mlmc > 0.0) || (mlqmc > 0.0) || (singleTerm > 0.0)
+        || (parametersFile.length() > 0)))
+        crash(__LINE__, __FILE__, __FUNCTION__, "-richardson applies to plain Monte Carlo and -convergence only");
+
+    if ((stages != 1) && ((mlmc <= 0.0) || (mlqmc > 0.0) || (singleTerm > 0.0) || (convergence > 0)
+        || (parametersFile.length() > 0)))
+        crash(__LINE__, __FILE__, __FUNCTION__, "-continuation applies to -mlmc only");
+
+    if ((parametersFile.length() > 0) && pipeline) {
+        if (watch)
+            crash(__LINE__, __FILE__, __FUNCTION__, "-pipeline and -watch cannot be combined");
+
+        return runPipeline(simulation, model, scheme, payoff, seed,
+            parametersFile, resultsFile, storeFile, workers, depth);
     }
 
+    if (parametersFile.length() > 0)
+        return runSweep(simulation, model, scheme, payoff, seed,
+            parametersFile, resultsFile, storeFile, watch);
+
+    if (convergence > 0)
+        return runConvergence(simulation, model, scheme, payoff, seed, convergence, richardson);
+
+    if (singleTerm > 0.0)
+        return runSingleTerm(simulation, model, scheme, payoff, seed, singleTerm, levels, antithetic,
+            adaptive, threads);
 
-    std::cout << std::endl << "======================" << std::endl
-        << "Simulation Parameters" << std::endl
-        << "======================" << std::endl
-        << "S0 = " << S0 << std::endl
-        << "r0 = " << r0 << std::endl
-        << "v0 = " << v0 << std::endl
-        << "T = " << T << std::endl << std::endl
-        << "sims = " << sims << std::endl
-        << "steps = " << steps << std::endl << std::endl
-        << "Closed form solution = " << actual << std::endl;
+    if (mlqmc > 0.0)
+        return runMultilevel(simulation, model, scheme, payoff, seed, mlqmc, levels, false, false, threads, 1, true);
 
-	std::cout << std::endl << "Correlation Matrix:" << std::endl;
+    if (mlmc > 0.0)
+        return runMultilevel(simulation, model, scheme, payoff, seed, mlmc, levels, antithetic, adaptive, threads, stages);
 
-	for (int i = 0; i < 3; i++) {
-		std::cout << " : ";
+    if ((shards == 0) || (shard >= shards))
+        crash(__LINE__, __FILE__, __FUNCTION__, "Invalid shard " 
+            + std::to_string(shard) + "/" + std::to_string(shards));
 
-		for (int j = 0; j < 3; j++) {
-			std::cout << rho[(i*3)+j] << " : ";
-		}
+    if ((shards > 1) && (partialFile.length() == 0))
+        partialFile = "partial." + std::to_string(shard) + ".bin";
 
-		std::cout << std::endl;
-	}
 
-	std::cout << std::endl;
+    LogLine(_LOG_INFO_, "Simulation parameters")
+        .field("S0", S0).field("r0", r0).field("v0", v0).field("T", T).field("K", K)
+        .field("sims", sims).field("steps", steps)
+        .field("shard", shard).field("shards", shards).field("seed", seed)
+        .field("model", model).field("scheme", scheme).field("payoff", payoff)
+        .field("richardson", richardson).field("actual", actual);
+
+    LogLine(_LOG_INFO_, "Correlation matrix")
+        .field("rho12", simulation.rho[0][1])
+        .field("rho13", simulation.rho[0][2])
+        .field("rho23", simulation.rho[1][2]);
 
     //
     // Perform simulation
     //
 
-    auto monteCarloResult = MonteCarlo(S0, v0, r0, T, K, Kv, 
-		Kr, sigmav, sigmar, vbar, rbar, steps, sims, actual,
-		rho);
+    auto monteCarloResult = MonteCarlo(simulation, model, scheme, payoff,
+		shard, shards, seed, partialFile, richardson);
 
 
 	//
 	// Display results
 	//
 
-    std::cout << std::endl << "======================" << std::endl
-        << "Simulation Results" << std::endl
-        << "======================" << std::endl
-        << "Mean = " << std::get<_Tuple_Mean_>(monteCarloResult) 
-		<< std::endl
-        << "Variance = " 
-		<< std::get<_Tuple_Variance_>(monteCarloResult) 
-		<< std::endl
-        << "Samples = " << std::get<_Tuple_Samples_>(monteCarloResult) 
-		<< std::endl << std::endl;
+    LogLine(_LOG_INFO_, "Simulation results")
+        .field("mean", std::get<_Tuple_Mean_>(monteCarloResult))
+        .field("variance", std::get<_Tuple_Variance_>(monteCarloResult))
+        .field("samples", std::get<_Tuple_Samples_>(monteCarloResult));
+
+    if (partialFile.length() > 0)
+        LogLine(_LOG_INFO_, "Partial result written").field("file", partialFile);
+
+    if (storeFile.length() > 0) {
+        ResultWriter store(storeFile);
+        storeResult(&store, parameterSet, steps, monteCarloResult);
+    }
 
     if (actual != 0.0) {
-        std::cout << "Weak Error = "
-			<< std::get<_Tuple_WeakError_>(monteCarloResult)
-			<< std::endl
-            << "Strong Error = " 
-			<< std::get<_Tuple_StrongError_>(monteCarloResult) 
-			<< std::endl;
+        LogLine(_LOG_INFO_, "Errors")
+            .field("weak", std::get<_Tuple_WeakError_>(monteCarloResult))
+            .field("strong", std::get<_Tuple_StrongError_>(monteCarloResult));
     }
 
 
@@ -27,6 +27,46 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Euler-Maruyama steps for S, v and r with
+ *                     path addressed random numbers, sharded
+ *                     execution with mergeable partial results
+ *
+ * 2026-10-19  JJL     Path loop moved to the policy templates
+ *                     in PathKernel.h
+ *
+ * 2026-10-19  JJL     Logging through Log.h
+ *
+ * 2026-10-19  JJL     storeResult() appends a pricing to a
+ *                     columnar result file
+ *
+ * 2026-10-19  JJL     MultilevelMonteCarlo() on the generic
+ *                     driver in MLMC.h
+ *
+ * 2026-10-19  JJL     Antithetic multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     MultiIndexMonteCarlo() for HHW
+ *
+ * 2026-10-19  JJL     Multilevel quasi-Monte Carlo
+ *
+ * 2026-10-19  JJL     Every multilevel pricing logs the level table
+ *                     of diagnoseLevels()
+ *
+ * 2026-10-19  JJL     SingleTermMonteCarlo(), randomized single term
+ *                     estimator on the level kernels
+ *
+ * 2026-10-19  JJL     Adaptive time steps for the multilevel and
+ *                     single term estimators
+ *
+ * 2026-10-19  JJL     Richardson-Romberg extrapolation in MonteCarlo()
+ *
+ * 2026-10-19  JJL     MLQMC levels limited by the Sobol dimensions
+ *
+ * 2026-10-19  JJL     Payoff quantiles from the block sketches
+ *
+ * 2026-10-19  JJL     MultiIndexMonteCarlo() removed with -mimc
+ *
+ * 2026-10-19  JJL     Antithetic level estimator for SingleTermMonteCarlo()
+ *
  */
 
 
@@ -42,32 +82,55 @@
 //
 
 #include "MonteCarlo.h"
+#include "Partial.h"
+#include "selectKernel.h"
+#include "QuasiRandom.h"
+#include "Welford.h"
+#include "Crash.h"
+#include "Log.h"
 
 
 //
 // Standard includes
 //
 
-#include <iostream>
-#include <iomanip>
 #include <math.h>
-#include <random>
 
 
 //
 // Function: MonteCarlo()
 //
 // Parameters:
+//    pparameters - Model parameters, steps, sims and closed form
+//    pmodel - gbm, heston or hhw
+//    pscheme - em, milstein, logeuler, qe or exact
+//    ppayoff - put, call or asset
+//    pshard, pshards - This shard and the number of shards
+//    pseed - Seed shared by every shard of the pricing
+//    ppartialFile - Partial result file, empty to skip writing it
+//    prichardson - Step refinements k, above 1 every sample is the
+//                  Richardson-Romberg extrapolation of coupled paths
+//                  with steps, 2 steps, ..., 2^(k-1) steps
 //
 // Returns:
+//    <Mean, Variance, Samples, WeakError, StrongError> over the paths
+//    simulated by this shard
+//
+// Comments:
+//    Paths are grouped into blocks of _Partial_Block_Size_.  Path p
+//    always draws from PathGenerator(pseed, p), and the block totals
+//    are always merged in block order, so the merged partials of any
+//    shard count reproduce the single run exactly.  With k > 1 the
+//    statistics are those of the extrapolated samples, whose variance
+//    includes the covariance of the coupled paths.
 //
 
 std::tuple<double, double, double, double, double>
 	MonteCarlo(
-    	double pS0, double pv0, double pr0, double pT, double pK, 
-    	double pKv, double pKr, double psigmav, double psigmar, 
-    	double pvbar, double prbar, unsigned int psteps, 
-		unsigned int psims, double pactual, double *prh0
+		SimulationParameters pparameters, std::string pmodel,
+		std::string pscheme, std::string ppayoff,
+		unsigned int pshard, unsigned int pshards, uint64_t pseed,
+		std::string ppartialFile, unsigned int prichardson
     ) {
 
     // <Mean, Variance, Samples, WeakError, StrongError>
@@ -79,67 +142,298 @@ std::tuple<double, double, double, double, double>
     std::get<_Tuple_WeakError_>(result) = 0.0;
     std::get<_Tuple_StrongError_>(result) = 0.0;
 	
+	if ((pshards == 0) || (pshard >= pshards)) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Invalid shard " 
+			+ std::to_string(pshard) + "/" + std::to_string(pshards));
+	}
+
 	//
 	// Variables
 	//
 
-	double dt = pT / static_cast<double>(psteps);
+	double dt = pparameters.T / static_cast<double>(pparameters.steps);
 	double sqrtdt = sqrt(dt);
 
-	std::cout << "dt = " << dt << ", sqrtdt = " << sqrtdt << std::endl;
- 
-	double S = 0.0, v = 0.0, r = 0.0, dv = 0.0, dr = 0.0, dS = 0.0,
-		sumS = 0.0, weakSumS = 0.0;
-	
-	auto dW = new double[3];
+	LogLine(_LOG_DEBUG_, "Discretization").field("dt", dt).field("sqrtdt", sqrtdt);
+
+	if (prichardson == 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Richardson refinements must be at least 1");
+
+	auto kernel = selectKernel(pmodel, pscheme, ppayoff, pparameters.steps);
+	auto richardson = (prichardson > 1 ? selectRichardsonKernel(pmodel, pscheme, ppayoff, prichardson) : nullptr);
+
+	//
+	// Blocks owned by this shard
+	//
+
+	uint64_t blocks = (static_cast<uint64_t>(pparameters.sims) + _Partial_Block_Size_ - 1) / _Partial_Block_Size_;
+	auto range = shardBlocks(pshard, pshards, blocks);
 
-	// Random
-	std::default_random_engine randGenerator;
-	std::normal_distribution<double> randNorm(0.0, 1.0);
-	
 
 	//
 	// Perform simulations
 	//
 
-	for (auto sim = 0; sim < psims; sim++) {
-		S = pS0;
-		v = pv0;
-		r = pr0;
+	auto blockResults = (richardson != nullptr
+		? richardson(pparameters, std::get<_Shard_First_>(range), std::get<_Shard_Last_>(range), pseed, prichardson)
+		: kernel(pparameters, std::get<_Shard_First_>(range), std::get<_Shard_Last_>(range), pseed));
+
+	//
+	// Results
+	//
+
+	auto total = emptyBlock(0);
+
+	for (auto b : blockResults)
+		mergeBlock(&total, b);
+
+	LogLine(_LOG_INFO_, "Quantiles").field("q05", sketchQuantile(total, 0.05))
+		.field("median", sketchQuantile(total, 0.5)).field("q95", sketchQuantile(total, 0.95));
+
+	if (ppartialFile.length() > 0) {
+		auto& p = pparameters;
+
+		double hashed[] = { p.S0, p.v0, p.r0, p.T, p.K, p.Kv, p.Kr, p.sigmav, 
+			p.sigmar, p.vbar, p.rbar, p.actual, 
+			p.rho[0][1], p.rho[0][2], p.rho[1][2] };
+
+		PartialHeader header;
+		header.shard = pshard;
+		header.shards = pshards;
+		header.seed = pseed;
+		header.sims = p.sims;
+		header.steps = p.steps;
+		header.blockSize = _Partial_Block_Size_;
+		header.blocks = blocks;
+		header.parameterHash = hashParameters(hashed, sizeof(hashed) / sizeof(double),
+			pmodel + "/" + pscheme + "/" + ppayoff
+			+ (prichardson > 1 ? "/richardson" + std::to_string(prichardson) : ""));
+		header.actual = p.actual;
+
+		writePartial(ppartialFile, header, blockResults);
+	}
+
+	double samples = total.count;
+
+    std::get<_Tuple_Mean_>(result) = total.mean;
+    std::get<_Tuple_Variance_>(result) = (samples > 1.0 ? welfordVariance(&total.count, &total.mean, &total.M2) : 0.0);
+    std::get<_Tuple_Samples_>(result) = samples;
+    std::get<_Tuple_WeakError_>(result) = (samples > 0.0 ? total.sumError / samples : 0.0);
+    std::get<_Tuple_StrongError_>(result) = total.mean - pparameters.actual;
+
+    return result;
+}
+
 
-		for (auto step = 0; step < psteps; step++) {
+//
+// Function: logLevelTable()
+//
+// Parameters:
+//    plevels - Statistics of every level of a multilevel pricing
+//
+// Returns:
+//    Nothing, one line per level, the measured rates and a warning for
+//    every level that fails a check
+//
+
+static void logLevelTable(const std::vector<LevelSums>& plevels) {
+
+	auto diagnostics = diagnoseLevels(plevels);
 
-			dS = 0.0;
-			dr = 0.0;
-			dv = 0.0;
+	for (size_t l = 0; l < diagnostics.levels.size(); l++) {
+		auto& row = diagnostics.levels[l];
 
-			S += dS;
-			v += dv;
-			r += dr;
+		LogLine(_LOG_INFO_, "Level").field("level", static_cast<uint64_t>(l))
+			.field("samples", row.samples)
+			.field("mean", row.mean).field("variance", row.variance)
+			.field("meanFine", row.meanFine).field("varianceFine", row.varianceFine)
+			.field("cost", row.cost).field("us", 1e6 * row.seconds)
+			.field("kurtosis", row.kurtosis).field("consistency", row.consistency);
 
-			S = (S < 0.0 ? 0.0 : S);
-			r = (r < 0.0 ? 0.0 : r);
-			v = (v < 0.0 ? 0.0 : v);
-		}
+		if (row.consistency > 1.0)
+			LogLine(_LOG_WARN_, "Coarse path of the level does not match the fine path below it")
+				.field("level", static_cast<uint64_t>(l)).field("consistency", row.consistency);
 
-		sumS += S;
-		weakSumS += (S - pactual);
+		if (row.kurtosis > 100.0)
+			LogLine(_LOG_WARN_, "Kurtosis too high for a reliable variance")
+				.field("level", static_cast<uint64_t>(l)).field("kurtosis", row.kurtosis);
 	}
 
+	LogLine(_LOG_INFO_, "Measured rates")
+		.field("alpha", diagnostics.alpha).field("beta", diagnostics.beta)
+		.field("gamma", diagnostics.gamma).field("gammaTime", diagnostics.gammaSeconds);
+}
+
+
+//
+// Function: MultilevelMonteCarlo()
+//
+// Parameters:
+//    pparameters - Model parameters, steps is the number of steps on
+//                  level 0 and level l takes steps 2^l
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    poptions - Target RMSE and level limits
+//    pantithetic - Antithetic estimator, each fine path averaged with
+//                  the twin that takes its increments in swapped pairs
+//    padaptive - Path dependent time steps, level l takes 2^-l times
+//                the step the state of the path allows
+//
+// Returns:
+//    Multilevel estimate and the statistics of every level
+//
+
+MLMCResult MultilevelMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const MLMCOptions& poptions,
+	bool pantithetic, bool padaptive) {
+
+	auto kernel = selectLevelKernel(pmodel, pscheme, ppayoff, pantithetic, padaptive);
+
+	auto estimator = [&](unsigned int plevel, uint64_t pfirst, uint64_t pcount) {
+		return kernel(pparameters, plevel, pfirst, pcount, pseed);
+	};
+
+	auto result = multilevelMonteCarlo(estimator, poptions);
+
+	logLevelTable(result.levels);
+
+	if (!result.converged)
+		LogLine(_LOG_WARN_, "MLMC bias above target at the finest level")
+			.field("levels", static_cast<uint64_t>(result.levels.size()));
+
+	return result;
+}
+
+
+//
+// Function: MultilevelQuasiMonteCarlo()
+//
+// Parameters:
+//    pparameters - Model parameters, steps is the number of steps on
+//                  level 0 and level l takes steps 2^l
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the randomizations
+//    poptions - Target RMSE and level limits
+//
+// Returns:
+//    Multilevel estimate and the statistics of every level
+//
+
+MLMCResult MultilevelQuasiMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const MLMCOptions& poptions) {
+
+	auto kernel = selectQuasiLevelKernel(pmodel, pscheme, ppayoff);
+
+	auto estimator = [&](unsigned int plevel, unsigned int prandomization, uint64_t pfirst, uint64_t pcount) {
+		return kernel(pparameters, plevel, prandomization, pfirst, pcount, pseed);
+	};
+
 	//
-	// Results
+	// A point of level l has factors x steps 2^l coordinates, and the
+	// Sobol directions run out at _Sobol_Max_Dimensions_.  The levels
+	// stop there, and a bias still above target or untested for want
+	// of levels is reported as not converged.
 	//
 
-	sumS = sumS / static_cast<double>(psims);
-	weakSumS = weakSumS / static_cast<double>(psims);
+	auto options = poptions;
+	uint64_t dimensions = static_cast<uint64_t>(modelFactors(pmodel)) * (pparameters.steps > 0 ? pparameters.steps : 1);
+	unsigned int levels = 0;
 
+	while ((levels < options.maxLevels) && ((dimensions << levels) <= _Sobol_Max_Dimensions_))
+		levels++;
 
-    std::get<_Tuple_Mean_>(result) = sumS;
-    std::get<_Tuple_Variance_>(result) = 0.0;
-    std::get<_Tuple_Samples_>(result) = 0.0;
-    std::get<_Tuple_WeakError_>(result) = weakSumS;
-    std::get<_Tuple_StrongError_>(result) = sumS - pactual;
+	if (levels == 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, std::to_string(dimensions) + " Sobol dimensions per point"
+			+ " on level 0, at most " + std::to_string(_Sobol_Max_Dimensions_));
 
-    return result;
+	if (levels < options.maxLevels)
+		LogLine(_LOG_WARN_, "MLQMC levels limited by the Sobol dimensions")
+			.field("levels", static_cast<uint64_t>(levels))
+			.field("dimensions", static_cast<uint64_t>(_Sobol_Max_Dimensions_));
+
+	options.maxLevels = levels;
+
+	auto result = multilevelQuasiMonteCarlo(estimator, options);
+
+	logLevelTable(result.levels);
+
+	if (!result.converged)
+		LogLine(_LOG_WARN_, "MLQMC bias above target at the finest level")
+			.field("levels", static_cast<uint64_t>(result.levels.size()));
+
+	return result;
+}
+
+
+//
+// Function: SingleTermMonteCarlo()
+//
+// Parameters:
+//    pparameters - Model parameters, steps is the number of steps on
+//                  level 0 and level l takes steps 2^l
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers and the level
+//            draws
+//    poptions - Target standard error and level limit
+//    pantithetic, padaptive - Level estimator, as MultilevelMonteCarlo()
+//
+// Returns:
+//    Unbiased estimate of the finest level and the level distribution
+//
+
+SingleTermResult SingleTermMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const SingleTermOptions& poptions,
+	bool pantithetic, bool padaptive) {
+
+	auto kernel = selectLevelKernel(pmodel, pscheme, ppayoff, pantithetic, padaptive);
+
+	auto estimator = [&](unsigned int plevel, uint64_t pfirst, uint64_t pcount) {
+		return kernel(pparameters, plevel, pfirst, pcount, pseed);
+	};
+
+	auto options = poptions;
+	options.seed = pseed;
+
+	auto result = singleTermMonteCarlo(estimator, options);
+
+	for (size_t l = 0; l < result.probabilities.size(); l++)
+		if (result.drawn[l] > 0.0)
+			LogLine(_LOG_INFO_, "Level").field("level", static_cast<uint64_t>(l))
+				.field("probability", result.probabilities[l]).field("samples", result.drawn[l]);
+
+	if (result.beta <= result.gamma)
+		LogLine(_LOG_WARN_, "Variance decays no faster than cost grows, the work depends on the finest level")
+			.field("beta", result.beta).field("gamma", result.gamma)
+			.field("maxLevel", static_cast<uint64_t>(options.maxLevel));
+
+	return result;
 }
 
+
+//
+// Function: storeResult()
+//
+// Parameters:
+//    pwriter - Result file
+//    pparameterSet - Id of the parameter set
+//    psteps - Time steps of the pricing
+//    presult - Tuple returned by MonteCarlo()
+//
+// Returns:
+//    Nothing
+//
+
+void storeResult(ResultWriter* pwriter, uint64_t pparameterSet, unsigned int psteps,
+	const std::tuple<double, double, double, double, double>& presult) {
+
+	double row[_RESULT_WIDTH_];
+
+	row[_RESULT_MEAN_] = std::get<_Tuple_Mean_>(presult);
+	row[_RESULT_VAR_] = std::get<_Tuple_Variance_>(presult);
+	row[_RESULT_N_] = std::get<_Tuple_Samples_>(presult);
+	row[_RESULT_STEPS_] = static_cast<double>(psteps);
+	row[_ERROR_WEAK_] = std::get<_Tuple_WeakError_>(presult);
+	row[_ERROR_STRONG_] = std::get<_Tuple_StrongError_>(presult);
+
+	pwriter->append(pparameterSet, row);
+}
@@ -27,6 +27,36 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Sharded execution with mergeable
+ *                     partial results
+ *
+ * 2026-10-19  JJL     SimulationParameters replaces the
+ *                     positional arguments, model, scheme and
+ *                     payoff select a specialized kernel
+ *
+ * 2026-10-19  JJL     storeResult() appends a pricing to a
+ *                     columnar result file
+ *
+ * 2026-10-19  JJL     MultilevelMonteCarlo() on the generic
+ *                     driver in MLMC.h
+ *
+ * 2026-10-19  JJL     Antithetic multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     MultiIndexMonteCarlo() for HHW
+ *
+ * 2026-10-19  JJL     Multilevel quasi-Monte Carlo
+ *
+ * 2026-10-19  JJL     Randomized single term multilevel estimator
+ *
+ * 2026-10-19  JJL     Adaptive time steps for the multilevel and
+ *                     single term estimators
+ *
+ * 2026-10-19  JJL     Richardson-Romberg extrapolation in MonteCarlo()
+ *
+ * 2026-10-19  JJL     MultiIndexMonteCarlo() removed with -mimc
+ *
+ * 2026-10-19  JJL     Antithetic level estimator for SingleTermMonteCarlo()
+ *
  */
 
 #pragma once
@@ -38,6 +68,25 @@
 #include <tuple>
 
 
+//
+// Standard includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// Local includes
+//
+
+#include "Simulation.h"
+#include "ResultStore.h"
+#include "MLMC.h"
+#include "MLQMC.h"
+#include "SingleTerm.h"
+
+
 //
 // Definitions
 //
@@ -55,9 +104,71 @@
 
 std::tuple<double, double, double, double, double>
 	MonteCarlo(
-    	double pS0, double pv0, double pr0, double pT, double pK,
-    	double pKv, double pKr, double psigmav, double psigmar,
-    	double pvbar, double prbar, unsigned int psteps, 
-		unsigned int psims, double pactual, double *prho
+		SimulationParameters pparameters, std::string pmodel,
+		std::string pscheme, std::string ppayoff,
+		unsigned int pshard, unsigned int pshards, uint64_t pseed,
+		std::string ppartialFile, unsigned int prichardson = 1
 	);
 
+
+//
+// Function: storeResult()
+//
+
+void storeResult(ResultWriter* pwriter, uint64_t pparameterSet, unsigned int psteps,
+	const std::tuple<double, double, double, double, double>& presult);
+
+
+//
+// Function: MultilevelMonteCarlo()
+//
+// Parameters:
+//    pparameters - Model parameters, steps is the number of steps on
+//                  level 0
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    poptions - Target RMSE and level limits
+//    pantithetic - Antithetic estimator, each fine path averaged with
+//                  the twin that takes its increments in swapped pairs
+//    padaptive - Path dependent time steps that refine as v or r
+//                nears zero
+//
+// Returns:
+//    Multilevel estimate and the statistics of every level
+//
+
+MLMCResult MultilevelMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const MLMCOptions& poptions,
+	bool pantithetic = false, bool padaptive = false);
+
+
+//
+// Function: MultilevelQuasiMonteCarlo()
+//
+// Parameters:
+//    As MultilevelMonteCarlo(), the levels are sampled with randomized
+//    Sobol points through a Brownian bridge
+//
+// Returns:
+//    Multilevel estimate, its variance from the randomizations
+//
+
+MLMCResult MultilevelQuasiMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const MLMCOptions& poptions);
+
+
+//
+// Function: SingleTermMonteCarlo()
+//
+// Parameters:
+//    As MultilevelMonteCarlo(), every sample draws its own level and
+//    poptions sets the target standard error and the finest level
+//
+// Returns:
+//    Unbiased estimate of the finest level and the level distribution
+//
+
+SingleTermResult SingleTermMonteCarlo(SimulationParameters pparameters, std::string pmodel,
+	std::string pscheme, std::string ppayoff, uint64_t pseed, const SingleTermOptions& poptions,
+	bool pantithetic = false, bool padaptive = false);
+
@@ -0,0 +1,210 @@
+/*
+ * Pipelined parameter file sweep
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local includes
+//
+
+#include "Pipeline.h"
+#include "Sweep.h"
+#include "MonteCarlo.h"
+#include "ResultStore.h"
+#include "Parameters.h"
+#include "ParameterTable.h"
+#include "BoundedQueue.h"
+#include "ReturnValues.h"
+#include "Crash.h"
+#include "Log.h"
+
+
+//
+// STL includes
+//
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+
+//
+// Standard includes
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <thread>
+
+
+//
+// Structure: PricedRow
+//
+
+struct PricedRow {
+	uint64_t index;
+	std::vector<double> key;
+	std::tuple<double, double, double, double, double> price;
+};
+
+
+//
+// Function: writeRow()
+//
+
+static void writeRow(std::ostream& pout, const PricedRow& prow) {
+
+	double samples = std::get<_Tuple_Samples_>(prow.price);
+	double stdError = (samples > 0.0 ? sqrt(std::get<_Tuple_Variance_>(prow.price) / samples) : 0.0);
+
+	pout << prow.index;
+
+	for (auto x : prow.key)
+		pout << ", " << x;
+
+	pout << ", " << std::get<_Tuple_Mean_>(prow.price)
+		<< ", " << stdError
+		<< ", " << std::get<_Tuple_StrongError_>(prow.price) << "\n";
+}
+
+
+//
+// Function: runPipeline()
+//
+
+int runPipeline(SimulationParameters pbase, std::string pmodel, std::string pscheme,
+	std::string ppayoff, uint64_t pseed, std::string pfilename,
+	std::string presultsFile, std::string pstoreFile,
+	unsigned int pworkers, unsigned int pdepth) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (pworkers == 0)
+		pworkers = std::max(1u, std::thread::hardware_concurrency());
+
+	// The header row is read here, so a bad file fails before any thread starts
+	ParameterReader reader(pfilename);
+	auto base = baseKey(pbase);
+	auto present = reader.present();
+
+	std::unique_ptr<ResultWriter> store;
+
+	if (pstoreFile.length() > 0)
+		store.reset(new ResultWriter(pstoreFile));
+
+	std::ofstream outFile;
+
+	if (presultsFile.length() > 0) {
+		outFile.open(presultsFile, std::ios::out | std::ios::trunc);
+
+		if (!outFile.is_open())
+			crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + presultsFile);
+	}
+	else
+		logFlush();
+
+	std::ostream& out = (presultsFile.length() > 0 ? static_cast<std::ostream&>(outFile) : std::cout);
+
+	BoundedQueue<ParameterRow> rows(pdepth);
+	BoundedQueue<PricedRow> priced(pdepth);
+
+	//
+	// Reader
+	//
+
+	std::thread readerThread([&] {
+		ParameterRow row;
+
+		while (reader.next(&row))
+			rows.push(row);
+
+		rows.close();
+	});
+
+	//
+	// Workers
+	//
+
+	std::atomic<unsigned int> running(pworkers);
+	std::vector<std::thread> workers;
+
+	for (auto w = 0u; w < pworkers; w++) {
+		workers.emplace_back([&] {
+			ParameterRow row;
+
+			while (rows.pop(&row)) {
+				PricedRow result;
+				result.index = row.index;
+				result.key = base;
+
+				for (auto c = 0u; c < _Number_Of_Parameters_; c++) {
+					if ((present >> c) & 1)
+						result.key[c] = row.values[c];
+				}
+
+				auto simulation = sweepParameters(pbase, result.key);
+				result.price = MonteCarlo(simulation, pmodel, pscheme, ppayoff, 0, 1, pseed, "");
+
+				LogLine(_LOG_DEBUG_, "Priced").field("row", row.index).field("K", simulation.K)
+					.field("T", simulation.T).field("mean", std::get<_Tuple_Mean_>(result.price));
+
+				priced.push(std::move(result));
+			}
+
+			// The last worker out ends the writer's input
+			if (running.fetch_sub(1) == 1)
+				priced.close();
+		});
+	}
+
+	//
+	// Writer, on this thread
+	//
+
+	out << std::setprecision(10);
+	out << "Row, K, T, v, Kv, sigmav, rho12, ClosedForm, Mean, StdError, Error" << "\n";
+
+	PricedRow result;
+	uint64_t written = 0;
+
+	while (priced.pop(&result)) {
+		writeRow(out, result);
+
+		if (store)
+			storeResult(store.get(), result.index, pbase.steps, result.price);
+
+		written++;
+	}
+
+	out.flush();
+
+	readerThread.join();
+
+	for (auto& worker : workers)
+		worker.join();
+
+	if (outFile.is_open() && !outFile.good())
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to write " + presultsFile);
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	LogLine(_LOG_INFO_, "Pipelined sweep").field("rows", written)
+		.field("bad", static_cast<uint64_t>(reader.errors().size()))
+		.field("workers", pworkers).field("depth", pdepth).field("ms", elapsed);
+
+	return _OKAY_;
+}
@@ -0,0 +1,74 @@
+/*
+ * Pipelined parameter file sweep
+ *
+ * The sweep of Sweep.cpp loads the whole parameter file, prices every
+ * row and then writes the table, so nothing is simulated until the
+ * file is read and nothing is written until the last row is priced.
+ * Here the three run as stages joined by bounded queues:
+ *
+ *    reader  - streams rows out of the mapped file through the
+ *              tokenizer (ParameterReader)
+ *    workers - price parameter sets as they arrive
+ *    writer  - appends priced rows to the results table and the
+ *              result file as they complete
+ *
+ * Memory is bounded by the queue depth whatever the size of the file.
+ * Rows are written in completion order and carry their row number.
+ * Every row is priced, there is no cache of repeated rows as in the
+ * watch mode sweep, since it would grow with the file.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// Local includes
+//
+
+#include "Simulation.h"
+
+
+//
+// Definitions
+//
+
+#define _Pipeline_Depth_   64
+
+
+//
+// Function: runPipeline()
+//
+// Parameters:
+//    pbase - Parameters not present in the file (S0, r0, Kr, ...)
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    pfilename - Parameter file, see Common/parameters.csv
+//    presultsFile - Results table, empty for stdout
+//    pstoreFile - Columnar result file, empty to skip
+//    pworkers - Simulation threads, 0 for one per core
+//    pdepth - Capacity of each queue
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+int runPipeline(SimulationParameters pbase, std::string pmodel, std::string pscheme,
+	std::string ppayoff, uint64_t pseed, std::string pfilename,
+	std::string presultsFile, std::string pstoreFile,
+	unsigned int pworkers, unsigned int pdepth = _Pipeline_Depth_);
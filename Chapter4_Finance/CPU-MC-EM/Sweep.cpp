@@ -0,0 +1,367 @@
+/*
+ * Single threaded CPU Based Monte Carlo Simulation of European Put
+ * Euler-Muryama Method
+ *
+ * Implementation of
+ * Alexey Medvedev, Olivier Scaillet "Pricing American options under
+ * stochastic volatility and stochastic interest rates"
+ * Journal of Financial Economics. 2010.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2014
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2014-10-07  JJL     Initial version
+ *
+ * 2014-10-20  JJL     Stochastic volatility and
+ *                     stochastic interest rate
+ *
+ * 2014-10-28  JJL     Added Multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     Parameter file sweep with incremental
+ *                     re-pricing in watch mode
+ *
+ * 2026-10-19  JJL     Logging through Log.h
+ *
+ * 2026-10-19  JJL     Typed ParameterTable loader, bad rows are
+ *                     reported and skipped
+ *
+ * 2026-10-19  JJL     Priced rows appended to a result file
+ *
+ * 2026-10-19  JJL     baseKey() and sweepParameters() shared with
+ *                     the pipelined sweep
+ *
+ */
+
+
+//
+// Local includes
+//
+
+#include "Sweep.h"
+#include "MonteCarlo.h"
+#include "ResultStore.h"
+#include "Parameters.h"
+#include "ReturnValues.h"
+#include "ParameterTable.h"
+#include "createMatrix.h"
+#include "Crash.h"
+#include "Log.h"
+
+
+//
+// STL includes
+//
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+
+//
+// Standard includes
+//
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <limits.h>
+#endif
+
+
+//
+// Types
+//
+
+typedef std::tuple<double, double, double, double, double> PriceResult;
+typedef std::map<std::vector<double>, PriceResult> PriceCache;
+
+
+//
+// Function: baseKey()
+//
+// Parameters:
+//    pbase - Parameters given on the command line
+//
+// Returns:
+//    The swept parameters of pbase in Parameters.h order
+//
+
+std::vector<double> baseKey(const SimulationParameters& pbase) {
+
+	std::vector<double> key(_Number_Of_Parameters_);
+
+	key[_K_] = pbase.K;
+	key[_T_] = pbase.T;
+	key[_v_] = pbase.v0;
+	key[_Kv_] = pbase.Kv;
+	key[_sigmav_] = pbase.sigmav;
+	key[_rho12_] = pbase.rho[0][1];
+	key[_ClosedForm_] = pbase.actual;
+
+	return key;
+}
+
+
+//
+// Function: sweepParameters()
+//
+// Parameters:
+//    pbase - Parameters not present in the file (S0, r0, Kr, ...)
+//    pkey - Swept parameters in Parameters.h order
+//
+// Returns:
+//    pbase with the swept parameters replaced
+//
+
+SimulationParameters sweepParameters(const SimulationParameters& pbase,
+	const std::vector<double>& pkey) {
+
+	SimulationParameters simulation = pbase;
+	simulation.K = pkey[_K_];
+	simulation.T = pkey[_T_];
+	simulation.v0 = pkey[_v_];
+	simulation.Kv = pkey[_Kv_];
+	simulation.sigmav = pkey[_sigmav_];
+	simulation.actual = pkey[_ClosedForm_];
+	simulation.rho = createMatrix(pkey[_rho12_], pbase.rho[0][2], pbase.rho[1][2]);
+
+	return simulation;
+}
+
+
+//
+// Function: rowKey()
+//
+// Parameters:
+//    ptable - Parameter table
+//    prow - Row of the table
+//    pbase - Values of the columns the file does not have
+//
+// Returns:
+//    Parameters of the row in Parameters.h order
+//
+
+static std::vector<double> rowKey(const ParameterTable& ptable, uint64_t prow,
+	const SimulationParameters& pbase) {
+
+	auto key = baseKey(pbase);
+
+	for (auto c = 0u; c < _Number_Of_Parameters_; c++) {
+		if (ptable.present(c))
+			key[c] = ptable.value(prow, c);
+	}
+
+	return key;
+}
+
+
+//
+// Function: writeTable()
+//
+// Parameters:
+//    pout - Stream to write to
+//    ptable - Parameter rows in file order
+//    pbase - Values of the columns the file does not have
+//    pcache - Prices keyed by row
+//
+
+static void writeTable(std::ostream& pout, const ParameterTable& ptable,
+	const SimulationParameters& pbase, const PriceCache& pcache) {
+
+	pout << "Row, K, T, v, Kv, sigmav, rho12, ClosedForm, Mean, StdError, Error" << "\n";
+
+	for (uint64_t i = 0; i < ptable.rows(); i++) {
+		auto row = rowKey(ptable, i, pbase);
+		auto& price = pcache.at(row);
+
+		double samples = std::get<_Tuple_Samples_>(price);
+		double stdError = (samples > 0.0 ? sqrt(std::get<_Tuple_Variance_>(price) / samples) : 0.0);
+
+		pout << i;
+
+		for (auto x : row)
+			pout << ", " << x;
+
+		pout << ", " << std::get<_Tuple_Mean_>(price)
+			<< ", " << stdError
+			<< ", " << std::get<_Tuple_StrongError_>(price) << "\n";
+	}
+}
+
+
+//
+// Function: priceFile()
+//
+// Parameters:
+//    See runSweep()
+//    pcache - Prices of previously seen rows, updated in place
+//    pstore - Result file for newly priced rows, may be null
+//
+// Returns:
+//    Nothing
+//
+// Comments:
+//    A row is identified by its parsed values, so rows that were
+//    only moved or re-formatted keep their price.  Rows that are no
+//    longer in the file are dropped from the cache.
+//
+
+static void priceFile(SimulationParameters pbase, std::string pmodel, std::string pscheme,
+	std::string ppayoff, uint64_t pseed, std::string pfilename,
+	std::string presultsFile, PriceCache& pcache, ResultWriter* pstore) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	ParameterTable table(pfilename);
+
+	PriceCache current;
+	unsigned int repriced = 0;
+
+	for (uint64_t i = 0; i < table.rows(); i++) {
+		auto row = rowKey(table, i, pbase);
+
+		if (current.count(row) > 0)
+			continue;
+
+		auto cached = pcache.find(row);
+
+		if (cached != pcache.end()) {
+			current[row] = cached->second;
+			continue;
+		}
+
+		auto simulation = sweepParameters(pbase, row);
+
+		current[row] = MonteCarlo(simulation, pmodel, pscheme, ppayoff, 0, 1, pseed, "");
+		repriced++;
+
+		if (pstore != nullptr)
+			storeResult(pstore, i, simulation.steps, current[row]);
+
+		LogLine(_LOG_DEBUG_, "Priced").field("K", simulation.K).field("T", simulation.T)
+			.field("mean", std::get<_Tuple_Mean_>(current[row]));
+	}
+
+	pcache.swap(current);
+
+	//
+	// Results table
+	//
+
+	if (presultsFile.length() > 0) {
+		// Write beside the target and rename so readers never see a partial table
+		std::string temporary = presultsFile + ".tmp";
+
+		{
+			std::ofstream outFile(temporary, std::ios::out | std::ios::trunc);
+
+			if (!outFile.is_open())
+				crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + temporary);
+
+			outFile << std::setprecision(10);
+			writeTable(outFile, table, pbase, pcache);
+		}
+
+		if (std::rename(temporary.c_str(), presultsFile.c_str()) != 0)
+			crash(__LINE__, __FILE__, __FUNCTION__, "Unable to replace " + presultsFile);
+	}
+	else {
+		logFlush();
+		writeTable(std::cout, table, pbase, pcache);
+		std::cout.flush();
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	LogLine(_LOG_INFO_, "Repriced").field("rows", repriced)
+		.field("of", table.rows()).field("bad", static_cast<uint64_t>(table.errors().size()))
+		.field("ms", elapsed);
+}
+
+
+//
+// Function: runSweep()
+//
+
+int runSweep(SimulationParameters pbase, std::string pmodel, std::string pscheme,
+	std::string ppayoff, uint64_t pseed, std::string pfilename,
+	std::string presultsFile, std::string pstoreFile, bool pwatch) {
+
+	PriceCache cache;
+	std::unique_ptr<ResultWriter> store;
+
+	if (pstoreFile.length() > 0)
+		store.reset(new ResultWriter(pstoreFile));
+
+	priceFile(pbase, pmodel, pscheme, ppayoff, pseed, pfilename, presultsFile, cache, store.get());
+
+	if (!pwatch)
+		return _OKAY_;
+
+#ifdef __linux__
+	//
+	// Watch the directory rather than the file, editors and copy
+	// tools usually replace the file instead of writing it in place
+	//
+
+	auto slash = pfilename.find_last_of("/");
+	std::string directory = (slash == std::string::npos ? "." : pfilename.substr(0, slash));
+	std::string name = (slash == std::string::npos ? pfilename : pfilename.substr(slash + 1));
+
+	int notify = inotify_init();
+
+	if (notify < 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "inotify_init failed");
+
+	if (inotify_add_watch(notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to watch " + directory);
+
+	LogLine(_LOG_INFO_, "Watching").field("file", pfilename);
+
+	alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+
+	while (true) {
+		auto length = read(notify, buffer, sizeof(buffer));
+
+		if (length <= 0)
+			crash(__LINE__, __FILE__, __FUNCTION__, "Reading inotify events failed");
+
+		bool changed = false;
+
+		for (char* p = buffer; p < buffer + length; ) {
+			auto event = reinterpret_cast<struct inotify_event*>(p);
+
+			if ((event->len > 0) && (name == event->name))
+				changed = true;
+
+			p += sizeof(struct inotify_event) + event->len;
+		}
+
+		if (changed)
+			priceFile(pbase, pmodel, pscheme, ppayoff, pseed, pfilename, presultsFile, cache, store.get());
+	}
+#else
+	crash(__LINE__, __FILE__, __FUNCTION__, "Watch mode needs inotify (Linux)");
+#endif
+
+	return _OKAY_;
+}
@@ -0,0 +1,105 @@
+/*
+ * Single threaded CPU Based Monte Carlo Simulation of European Put
+ * Euler-Muryama Method
+ *
+ * Implementation of
+ * Alexey Medvedev, Olivier Scaillet "Pricing American options under
+ * stochastic volatility and stochastic interest rates"
+ * Journal of Financial Economics. 2010.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2014
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2014-10-07  JJL     Initial version
+ *
+ * 2014-10-20  JJL     Stochastic volatility and
+ *                     stochastic interest rate
+ *
+ * 2014-10-28  JJL     Added Multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     Parameter file sweep with incremental
+ *                     re-pricing in watch mode
+ *
+ * 2026-10-19  JJL     Priced rows appended to a result file
+ *
+ * 2026-10-19  JJL     baseKey() and sweepParameters() shared with
+ *                     the pipelined sweep
+ *
+ */
+
+#pragma once
+
+//
+// Standard includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// STL includes
+//
+
+#include <vector>
+
+
+//
+// Local includes
+//
+
+#include "Simulation.h"
+
+
+//
+// Function: runSweep()
+//
+// Parameters:
+//    pbase - Parameters not present in the file (S0, r0, Kr, ...)
+//    pmodel, pscheme, ppayoff - Kernel selection
+//    pseed - Seed of the path addressed random numbers
+//    pfilename - Parameter file, see Common/parameters.csv
+//    presultsFile - Results table, empty for stdout only
+//    pstoreFile - Columnar result file, empty to skip; every priced
+//                 row is appended with its row number as the id
+//    pwatch - Keep running and re-price whenever the file changes
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+int runSweep(SimulationParameters pbase, std::string pmodel, std::string pscheme,
+	std::string ppayoff, uint64_t pseed, std::string pfilename,
+	std::string presultsFile, std::string pstoreFile, bool pwatch);
+
+
+//
+// Function: baseKey()
+//
+// Returns:
+//    The swept parameters of pbase in Parameters.h order, the values
+//    used for the columns a parameter file does not have
+//
+
+std::vector<double> baseKey(const SimulationParameters& pbase);
+
+
+//
+// Function: sweepParameters()
+//
+// Returns:
+//    pbase with the swept parameters of pkey (Parameters.h order)
+//
+
+SimulationParameters sweepParameters(const SimulationParameters& pbase,
+	const std::vector<double>& pkey);
@@ -0,0 +1,221 @@
+
+/*
+ * Arena allocator for per-run scratch buffers
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/Arena.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+
+//
+// Definitions
+//
+
+#define _Huge_Page_Size_   (2 * 1024 * 1024)
+
+
+//
+// Function: roundUp()
+//
+
+static size_t roundUp(size_t pValue, size_t pMultiple) {
+	return ((pValue + pMultiple - 1) / pMultiple) * pMultiple;
+}
+
+
+//
+// Function: Arena()
+//
+// Parameters:
+//    pBlockSize - Smallest block requested from the system
+//
+
+Arena::Arena(size_t pBlockSize) :
+	blockSize(pBlockSize), current(0), offset(0), usedBefore(0) {
+}
+
+
+Arena::~Arena() {
+	release();
+}
+
+
+//
+// Function: newBlock()
+//
+// Parameters:
+//    pBytes - Minimum size of the block
+//
+// Returns:
+//    A page aligned block.  Explicit huge pages are tried first, then
+//    transparent huge pages, then the regular heap.
+//
+
+Arena::ArenaBlock Arena::newBlock(size_t pBytes) {
+
+	ArenaBlock block;
+	block.size = roundUp(pBytes, _Huge_Page_Size_);
+	block.mapped = false;
+	block.base = nullptr;
+
+#ifdef __linux__
+	void* memory = mmap(nullptr, block.size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+	if (memory == MAP_FAILED) {
+		memory = mmap(nullptr, block.size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (memory != MAP_FAILED)
+			madvise(memory, block.size, MADV_HUGEPAGE);
+	}
+
+	if (memory != MAP_FAILED) {
+		block.base = static_cast<char*>(memory);
+		block.mapped = true;
+	}
+#endif
+
+	if (block.base == nullptr)
+		block.base = static_cast<char*>(aligned_alloc(4096, block.size));
+
+	if (block.base == nullptr) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to allocate arena block");
+	}
+
+	return block;
+}
+
+
+//
+// Function: allocateBytes()
+//
+// Parameters:
+//    pBytes - Size of the buffer
+//    pAlignment - Power of two alignment of the buffer
+//
+// Returns:
+//    Uninitialized buffer, valid until the next reset() or release()
+//
+
+void* Arena::allocateBytes(size_t pBytes, size_t pAlignment) {
+
+	size_t request = (pBytes > blockSize ? pBytes : blockSize) + pAlignment;
+
+	if (blocks.empty())
+		blocks.push_back(newBlock(request));
+
+	for (;;) {
+		auto& block = blocks[current];
+		auto address = reinterpret_cast<uintptr_t>(block.base) + offset;
+		auto aligned = (address + pAlignment - 1) & ~static_cast<uintptr_t>(pAlignment - 1);
+		auto end = aligned + pBytes - reinterpret_cast<uintptr_t>(block.base);
+
+		if (end <= block.size) {
+			offset = end;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		// Blocks kept by reset() are reused before new ones are requested
+		usedBefore += block.size;
+		current++;
+		offset = 0;
+
+		if (current == blocks.size())
+			blocks.push_back(newBlock(request));
+	}
+}
+
+
+//
+// Function: reset()
+//
+// Description:
+//    Invalidates every buffer handed out and keeps the blocks
+//
+
+void Arena::reset() {
+	current = 0;
+	offset = 0;
+	usedBefore = 0;
+}
+
+
+//
+// Function: release()
+//
+// Description:
+//    Returns every block to the system
+//
+
+void Arena::release() {
+
+	for (auto& block : blocks) {
+#ifdef __linux__
+		if (block.mapped) {
+			munmap(block.base, block.size);
+			continue;
+		}
+#endif
+		free(block.base);
+	}
+
+	blocks.clear();
+	reset();
+}
+
+
+//
+// Function: used()
+//
+// Returns:
+//    Bytes handed out since the last reset, including alignment padding
+//
+
+size_t Arena::used() const {
+	return usedBefore + offset;
+}
+
+
+//
+// Function: reserved()
+//
+// Returns:
+//    Bytes held from the system
+//
+
+size_t Arena::reserved() const {
+
+	size_t total = 0;
+
+	for (auto& block : blocks)
+		total += block.size;
+
+	return total;
+}
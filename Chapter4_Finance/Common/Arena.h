@@ -0,0 +1,94 @@
+
+/*
+ * Arena allocator for per-run scratch buffers
+ *
+ * Buffers are carved out of large aligned blocks by bumping an offset.
+ * Nothing is freed individually.  reset() rewinds the arena in O(1)
+ * at the end of a configuration and keeps the blocks, so the next
+ * configuration reuses the same memory and peak memory stays flat
+ * across a convergence study.  Blocks are requested as huge pages on
+ * Linux when they are available and fall back to regular pages.
+ *
+ * Usage:
+ *    Arena arena;
+ *
+ *    for (each configuration) {
+ *       auto data = arena.allocate<double>(samples);
+ *       ...
+ *       arena.reset();
+ *    }
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstddef>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Definitions
+//
+
+#define _Arena_Block_Size_   (2 * 1024 * 1024)
+#define _Arena_Alignment_    64
+
+
+//
+// Class: Arena
+//
+
+class Arena {
+public:
+	Arena(size_t pBlockSize = _Arena_Block_Size_);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	void* allocateBytes(size_t pBytes, size_t pAlignment = _Arena_Alignment_);
+
+	template <typename T>
+	T* allocate(size_t pCount, size_t pAlignment = _Arena_Alignment_) {
+		return static_cast<T*>(allocateBytes(pCount * sizeof(T), pAlignment));
+	}
+
+	void reset();
+	void release();
+
+	size_t used() const;
+	size_t reserved() const;
+
+private:
+	struct ArenaBlock {
+		char* base;
+		size_t size;
+		bool mapped;
+	};
+
+	ArenaBlock newBlock(size_t pBytes);
+
+	std::vector<ArenaBlock> blocks;
+	size_t blockSize;
+	size_t current;
+	size_t offset;
+	size_t usedBefore;
+};
@@ -0,0 +1,117 @@
+
+/*
+ * Bounded blocking queue between pipeline stages
+ *
+ * push() blocks while the queue is full, which is what holds a fast
+ * producer back and keeps the memory of a pipeline bounded by the
+ * depth of its queues rather than the size of its input.  pop()
+ * blocks while the queue is empty and returns false once the queue
+ * is closed and drained, so consumers simply loop until it fails.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+
+//
+// STL Includes
+//
+
+#include <deque>
+
+
+//
+// Class: BoundedQueue
+//
+
+template <typename T>
+class BoundedQueue {
+public:
+	BoundedQueue(size_t pCapacity) : capacity(pCapacity > 0 ? pCapacity : 1), closed(false) {}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+	//
+	// Function: push()
+	//
+	// Returns:
+	//    false if the queue was closed and the item was dropped
+	//
+
+	bool push(T pItem) {
+		std::unique_lock<std::mutex> lock(mutex);
+
+		notFull.wait(lock, [this] { return closed || (items.size() < capacity); });
+
+		if (closed)
+			return false;
+
+		items.push_back(std::move(pItem));
+		notEmpty.notify_one();
+
+		return true;
+	}
+
+	//
+	// Function: pop()
+	//
+	// Returns:
+	//    false once the queue is closed and empty
+	//
+
+	bool pop(T* pItem) {
+		std::unique_lock<std::mutex> lock(mutex);
+
+		notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+
+		if (items.empty())
+			return false;
+
+		*pItem = std::move(items.front());
+		items.pop_front();
+		notFull.notify_one();
+
+		return true;
+	}
+
+	//
+	// Function: close()
+	//
+	// Description:
+	//    No more items will be pushed.  Items already queued are still
+	//    delivered.
+	//
+
+	void close() {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		closed = true;
+		notEmpty.notify_all();
+		notFull.notify_all();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+	std::deque<T> items;
+	size_t capacity;
+	bool closed;
+};
@@ -0,0 +1,340 @@
+
+/*
+ * Asynchronous buffered logging
+ *
+ * See also
+ * Vyukov, D. "Bounded MPMC queue."
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/Log.h"
+
+
+//
+// Standard Includes
+//
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+
+//
+// Structure: LogSlot
+//
+
+struct LogSlot {
+	std::atomic<size_t> sequence;
+	int level;
+	char text[_Log_Record_Size_];
+};
+
+
+//
+// Class: LogWriter
+//
+// Description:
+//    Owns the ring buffer and the thread that drains it.  A single
+//    instance is created on first use and destroyed at exit, which
+//    drains whatever is still queued, including on exit() from crash().
+//
+
+class LogWriter {
+public:
+	LogWriter() : enqueuePos(0), dequeuePos(0), dropped(0), running(true) {
+		for (size_t i = 0; i < _Log_Queue_Size_; i++)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+
+		drainer = std::thread(&LogWriter::drain, this);
+	}
+
+	~LogWriter() {
+		running.store(false, std::memory_order_release);
+		drainer.join();
+
+		auto lost = dropped.load(std::memory_order_relaxed);
+
+		if (lost > 0)
+			fprintf(stdout, "WARNING: log buffer overflowed, %" PRIu64 " records dropped\n", lost);
+
+		fflush(stdout);
+	}
+
+	bool push(int pLevel, const char* pText, unsigned int pLength) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		LogSlot* slot = nullptr;
+
+		for (;;) {
+			slot = &slots[pos & (_Log_Queue_Size_ - 1)];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+			if (difference == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+				pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		slot->level = pLevel;
+		std::memcpy(slot->text, pText, pLength);
+		slot->text[pLength] = 0;
+		slot->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	void flush() {
+		// Wait for the drainer to catch up with everything queued so far
+		size_t target = enqueuePos.load(std::memory_order_acquire);
+
+		while (dequeuePos.load(std::memory_order_acquire) < target)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+		fflush(stdout);
+	}
+
+private:
+	bool pop() {
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		LogSlot* slot = &slots[pos & (_Log_Queue_Size_ - 1)];
+
+		if (slot->sequence.load(std::memory_order_acquire) != pos + 1)
+			return false;
+
+		const char* prefix = "";
+
+		switch (slot->level) {
+		case _LOG_DEBUG_:
+			prefix = "DEBUG: ";
+			break;
+		case _LOG_WARN_:
+			prefix = "WARNING: ";
+			break;
+		case _LOG_ERROR_:
+			prefix = "ERROR: ";
+			break;
+		}
+
+		fputs(prefix, stdout);
+		fputs(slot->text, stdout);
+		fputc('\n', stdout);
+
+		slot->sequence.store(pos + _Log_Queue_Size_, std::memory_order_release);
+		dequeuePos.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	void drain() {
+		for (;;) {
+			bool stopping = !running.load(std::memory_order_acquire);
+			bool wrote = false;
+
+			while (pop())
+				wrote = true;
+
+			if (wrote)
+				fflush(stdout);
+			else if (stopping)
+				return;
+			else
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	LogSlot slots[_Log_Queue_Size_];
+
+	std::atomic<size_t> enqueuePos;
+	std::atomic<size_t> dequeuePos;
+	std::atomic<uint64_t> dropped;
+	std::atomic<bool> running;
+
+	std::thread drainer;
+};
+
+
+//
+// Globals
+//
+
+static std::atomic<int> logLevel(_LOG_INFO_);
+
+
+//
+// Function: logWriter()
+//
+
+static LogWriter& logWriter() {
+	static LogWriter writer;
+	return writer;
+}
+
+
+//
+// Function: logSetLevel()
+//
+// Parameters:
+//    pLevel - Lowest level written, _LOG_OFF_ suppresses everything
+//
+
+void logSetLevel(int pLevel) {
+	logLevel.store(pLevel, std::memory_order_relaxed);
+}
+
+
+//
+// Function: logEnabled()
+//
+
+bool logEnabled(int pLevel) {
+	return pLevel >= logLevel.load(std::memory_order_relaxed);
+}
+
+
+//
+// Function: logParseLevel()
+//
+// Parameters:
+//    pLevel - debug, info, warn, error or off
+//
+// Returns:
+//    Matching _LOG_*_ value, _LOG_INFO_ if unrecognized
+//
+
+int logParseLevel(std::string pLevel) {
+
+	if (pLevel == "debug")
+		return _LOG_DEBUG_;
+
+	if (pLevel == "warn")
+		return _LOG_WARN_;
+
+	if (pLevel == "error")
+		return _LOG_ERROR_;
+
+	if (pLevel == "off")
+		return _LOG_OFF_;
+
+	return _LOG_INFO_;
+}
+
+
+//
+// Function: logFlush()
+//
+// Description:
+//    Blocks until every record queued so far has been written.  Call
+//    before writing to stdout directly.
+//
+
+void logFlush() {
+	logWriter().flush();
+}
+
+
+//
+// Class: LogLine
+//
+
+LogLine::LogLine(int pLevel, const char* pMessage) :
+	enabled(logEnabled(pLevel)), level(pLevel), length(0) {
+
+	if (enabled)
+		append("%s", pMessage);
+}
+
+
+LogLine::~LogLine() {
+	if (enabled)
+		logWriter().push(level, text, length);
+}
+
+
+void LogLine::append(const char* pFormat, ...) {
+
+	if (length >= _Log_Record_Size_ - 1)
+		return;
+
+	va_list args;
+	va_start(args, pFormat);
+	int written = vsnprintf(text + length, _Log_Record_Size_ - length, pFormat, args);
+	va_end(args);
+
+	if (written > 0)
+		length += static_cast<unsigned int>(written);
+
+	if (length > _Log_Record_Size_ - 1)
+		length = _Log_Record_Size_ - 1;
+}
+
+
+LogLine& LogLine::field(const char* pKey, double pValue) {
+	if (enabled)
+		append(" %s=%g", pKey, pValue);
+
+	return *this;
+}
+
+
+LogLine& LogLine::field(const char* pKey, int64_t pValue) {
+	if (enabled)
+		append(" %s=%" PRId64, pKey, pValue);
+
+	return *this;
+}
+
+
+LogLine& LogLine::field(const char* pKey, uint64_t pValue) {
+	if (enabled)
+		append(" %s=%" PRIu64, pKey, pValue);
+
+	return *this;
+}
+
+
+LogLine& LogLine::field(const char* pKey, int pValue) {
+	return field(pKey, static_cast<int64_t>(pValue));
+}
+
+
+LogLine& LogLine::field(const char* pKey, unsigned int pValue) {
+	return field(pKey, static_cast<uint64_t>(pValue));
+}
+
+
+LogLine& LogLine::field(const char* pKey, const char* pValue) {
+	if (enabled)
+		append(" %s=%s", pKey, pValue);
+
+	return *this;
+}
+
+
+LogLine& LogLine::field(const char* pKey, const std::string& pValue) {
+	return field(pKey, pValue.c_str());
+}
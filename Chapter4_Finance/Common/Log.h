@@ -0,0 +1,96 @@
+
+/*
+ * Asynchronous buffered logging
+ *
+ * A log line is formatted by the calling thread into a fixed size
+ * record and pushed onto a lock-free ring buffer.  A background thread
+ * drains the buffer to stdout and only flushes once the buffer is
+ * empty, so logging from a hot loop never makes a system call.  When
+ * the buffer is full the record is dropped and counted instead of
+ * blocking the caller.
+ *
+ * Usage:
+ *    LogLine(_LOG_INFO_, "Simulation results")
+ *       .field("mean", mean)
+ *       .field("samples", samples);
+ *
+ * See also
+ * Vyukov, D. "Bounded MPMC queue."
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// Definitions
+//
+
+#define _LOG_DEBUG_   0
+#define _LOG_INFO_    1
+#define _LOG_WARN_    2
+#define _LOG_ERROR_   3
+#define _LOG_OFF_     4
+
+#define _Log_Record_Size_   512
+#define _Log_Queue_Size_    4096
+
+
+//
+// Function prototypes
+//
+
+void logSetLevel(int pLevel);
+
+bool logEnabled(int pLevel);
+
+int logParseLevel(std::string pLevel);
+
+void logFlush();
+
+
+//
+// Class: LogLine
+//
+// Description:
+//    Builds one record and queues it when it goes out of scope.  All
+//    work is skipped when the level is disabled.
+//
+
+class LogLine {
+public:
+	LogLine(int pLevel, const char* pMessage);
+	~LogLine();
+
+	LogLine& field(const char* pKey, double pValue);
+	LogLine& field(const char* pKey, int64_t pValue);
+	LogLine& field(const char* pKey, uint64_t pValue);
+	LogLine& field(const char* pKey, int pValue);
+	LogLine& field(const char* pKey, unsigned int pValue);
+	LogLine& field(const char* pKey, const char* pValue);
+	LogLine& field(const char* pKey, const std::string& pValue);
+
+private:
+	void append(const char* pFormat, ...);
+
+	bool enabled;
+	int level;
+	unsigned int length;
+	char text[_Log_Record_Size_];
+};
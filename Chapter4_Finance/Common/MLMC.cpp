@@ -0,0 +1,501 @@
+
+/*
+ * Generic multilevel Monte Carlo driver
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Levels sampled in cost weighted chunks on a
+ *                     work stealing pool
+ *
+ * 2026-10-19  JJL     optimalSamples() and sampleLevels() shared with
+ *                     the multi-index driver
+ *
+ * 2026-10-19  JJL     regressionSlope() shared with the quasi-Monte
+ *                     Carlo driver
+ *
+ * 2026-10-19  JJL     Third and fourth moments and wall time of each
+ *                     level, diagnoseLevels() for the level table
+ *
+ * 2026-10-19  JJL     Continuation over a decreasing sequence of
+ *                     tolerances
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/MLMC.h"
+#include "../Common/WorkStealing.h"
+#include "../Common/Welford.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <string>
+
+
+//
+// Function: emptyLevel()
+//
+
+LevelSums emptyLevel() {
+
+	LevelSums level;
+	level.count = 0.0;
+	level.mean = 0.0;
+	level.M2 = 0.0;
+	level.M3 = 0.0;
+	level.M4 = 0.0;
+	level.meanFine = 0.0;
+	level.M2Fine = 0.0;
+	level.cost = 0.0;
+	level.seconds = 0.0;
+
+	return level;
+}
+
+
+//
+// Function: accumulateLevel()
+//
+// Parameters:
+//    pLevel - Statistics to update
+//    pFine, pCoarse - P_l and P_(l-1) of one sample, pCoarse is 0 on
+//                     level 0
+//
+// Returns:
+//    Nothing, the caller adds the cost
+//
+
+void accumulateLevel(LevelSums* pLevel, double pFine, double pCoarse) {
+
+	double count = pLevel->count;
+
+	welfordMoments(&pLevel->count, &pLevel->mean, &pLevel->M2, &pLevel->M3, &pLevel->M4, pFine - pCoarse);
+	welford(&count, &pLevel->meanFine, &pLevel->M2Fine, pFine);
+}
+
+
+//
+// Function: mergeLevel()
+//
+
+void mergeLevel(LevelSums* pTotal, const LevelSums& pLevel) {
+
+	double count = pTotal->count;
+
+	welfordMomentsMerge(&pTotal->count, &pTotal->mean, &pTotal->M2, &pTotal->M3, &pTotal->M4,
+		pLevel.count, pLevel.mean, pLevel.M2, pLevel.M3, pLevel.M4);
+	welfordMerge(&count, &pTotal->meanFine, &pTotal->M2Fine,
+		pLevel.count, pLevel.meanFine, pLevel.M2Fine);
+
+	pTotal->cost += pLevel.cost;
+	pTotal->seconds += pLevel.seconds;
+}
+
+
+//
+// Function: levelVariance()
+//
+// Returns:
+//    Sample variance of Y_l
+//
+
+double levelVariance(const LevelSums& pLevel) {
+	return (pLevel.count > 1.0 ? pLevel.M2 / (pLevel.count - 1.0) : 0.0);
+}
+
+
+//
+// Function: regressionSlope()
+//
+// Parameters:
+//    pValues - Values of levels 0 ... L, level 0 is left out
+//
+// Returns:
+//    Least squares slope of log2(value) against the level
+//
+
+double regressionSlope(const std::vector<double>& pValues) {
+
+	double n = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+
+	for (size_t l = 1; l < pValues.size(); l++) {
+		if (pValues[l] <= 0.0)
+			continue;
+
+		double x = static_cast<double>(l);
+		double y = log2(pValues[l]);
+
+		n++;
+		sumX += x;
+		sumY += y;
+		sumXX += x * x;
+		sumXY += x * y;
+	}
+
+	double denominator = n * sumXX - sumX * sumX;
+
+	return (n >= 2.0 && denominator != 0.0 ? (n * sumXY - sumX * sumY) / denominator : 0.0);
+}
+
+
+//
+// Function: optimalSamples()
+//
+// Parameters:
+//    pV, pC - Variance and cost per sample of each level
+//    peps - Target root mean square error
+//
+// Returns:
+//    N_l minimizing sum N_l C_l subject to sum V_l / N_l = eps^2 / 2
+//
+
+std::vector<double> optimalSamples(const std::vector<double>& pV,
+	const std::vector<double>& pC, double peps) {
+
+	double sumVC = 0.0;
+
+	for (size_t l = 0; l < pV.size(); l++)
+		sumVC += sqrt(pV[l] * pC[l]);
+
+	std::vector<double> N(pV.size());
+
+	for (size_t l = 0; l < pV.size(); l++)
+		N[l] = ceil(2.0 * sqrt(pV[l] / pC[l]) * sumVC / (peps * peps));
+
+	return N;
+}
+
+
+//
+// Structure: LevelChunk
+//
+
+struct LevelChunk {
+	unsigned int level;
+	uint64_t first;
+	uint64_t count;
+	double cost;
+};
+
+
+//
+// Function: sampleLevels()
+//
+// Parameters:
+//    pEstimator - Sampler of the levels, any set of estimators
+//                 numbered 0 ... n - 1 will do
+//    pPool - Threads to run the chunks on
+//    pSums - Statistics of every level, updated in place
+//    pdN - Samples owed to each level
+//    pC - Estimated cost per sample of each level
+//
+// Returns:
+//    Nothing
+//
+
+void sampleLevels(const LevelEstimator& pEstimator, WorkStealingPool& pPool,
+	std::vector<LevelSums>* pSums, const std::vector<double>& pdN, const std::vector<double>& pC) {
+
+	double roundCost = 0.0;
+
+	for (size_t l = 0; l < pdN.size(); l++)
+		roundCost += pdN[l] * pC[l];
+
+	double chunkCost = roundCost / _MLMC_Round_Chunks_;
+
+	std::vector<LevelChunk> chunks;
+
+	for (size_t l = 0; l < pdN.size(); l++) {
+		auto remaining = static_cast<uint64_t>(pdN[l]);
+		auto first = static_cast<uint64_t>((*pSums)[l].count);
+		auto size = static_cast<uint64_t>(std::max(1.0, ceil(chunkCost / pC[l])));
+
+		while (remaining > 0) {
+			auto count = std::min(size, remaining);
+
+			chunks.push_back({ static_cast<unsigned int>(l), first, count, count * pC[l] });
+
+			first += count;
+			remaining -= count;
+		}
+	}
+
+	//
+	// Most expensive first, so the cheap chunks fill in at the end
+	//
+
+	std::vector<size_t> order(chunks.size());
+
+	for (size_t c = 0; c < order.size(); c++)
+		order[c] = c;
+
+	std::stable_sort(order.begin(), order.end(),
+		[&](size_t a, size_t b) { return chunks[a].cost > chunks[b].cost; });
+
+	std::vector<LevelSums> results(chunks.size());
+
+	pPool.run(order.size(), [&](size_t ptask) {
+		auto& chunk = chunks[order[ptask]];
+		auto start = std::chrono::steady_clock::now();
+
+		results[order[ptask]] = pEstimator(chunk.level, chunk.first, chunk.count);
+		results[order[ptask]].seconds =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	});
+
+	for (size_t c = 0; c < chunks.size(); c++)
+		mergeLevel(&(*pSums)[chunks[c].level], results[c]);
+}
+
+
+//
+// Function: telescope()
+//
+// Parameters:
+//    pResult - Result whose levels are summed into its estimate,
+//              variance and cost
+//
+
+static void telescope(MLMCResult* pResult) {
+
+	pResult->estimate = 0.0;
+	pResult->variance = 0.0;
+	pResult->cost = 0.0;
+
+	for (auto& level : pResult->levels) {
+		pResult->estimate += level.mean;
+		pResult->variance += levelVariance(level) / level.count;
+		pResult->cost += level.cost;
+	}
+}
+
+
+//
+// Function: multilevelMonteCarlo()
+//
+// Parameters:
+//    pEstimator - Sampler of the levels
+//    pOptions - Target RMSE, pilot size, level limits, any known decay
+//               rates and the continuation stages
+//
+// Returns:
+//    Estimate of E[P_L] and the statistics of every level used
+//
+// Comments:
+//    With continuation the stages solve eps r^(S-1), ..., eps r, eps
+//    in turn.  Each stage starts from the samples, levels and cost of
+//    the stage before, so a stage only adds what its tighter target
+//    needs, and the last stage costs about what a single run at eps
+//    would.  pOptions.stage sees every stage's result.
+//
+
+MLMCResult multilevelMonteCarlo(const LevelEstimator& pEstimator, const MLMCOptions& pOptions) {
+
+	if (pOptions.eps <= 0.0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Target RMSE must be positive");
+
+	// Two levels past level 0 are needed to estimate the decay rates
+	if ((pOptions.minLevels < 3) || (pOptions.maxLevels < pOptions.minLevels) || (pOptions.pilot < 2))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Invalid MLMC options: levels "
+			+ std::to_string(pOptions.minLevels) + " to " + std::to_string(pOptions.maxLevels)
+			+ ", pilot " + std::to_string(pOptions.pilot));
+
+	if ((pOptions.stages < 1) || (pOptions.stageRatio <= 1.0))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Invalid continuation: "
+			+ std::to_string(pOptions.stages) + " stages, ratio " + std::to_string(pOptions.stageRatio));
+
+	MLMCResult result;
+	result.alpha = std::max(0.0, pOptions.alpha);
+	result.beta = std::max(0.0, pOptions.beta);
+	result.gamma = std::max(0.0, pOptions.gamma);
+
+	auto& sums = result.levels;
+	sums.assign(pOptions.minLevels, emptyLevel());
+
+	std::vector<double> dN(pOptions.minLevels, static_cast<double>(pOptions.pilot));
+
+	// Cost per sample, guessed for the pilot and measured after it
+	std::vector<double> C(pOptions.minLevels);
+
+	for (size_t l = 0; l < C.size(); l++)
+		C[l] = pow(2.0, (pOptions.gamma > 0.0 ? pOptions.gamma : 1.0) * l);
+
+	WorkStealingPool pool(pOptions.threads);
+
+	for (unsigned int stage = 0; stage < pOptions.stages; stage++) {
+		double eps = pOptions.eps * pow(pOptions.stageRatio, pOptions.stages - 1 - stage);
+
+		result.converged = true;
+
+		do {
+
+			//
+			// Samples still owed to each level, none when a stage starts
+			// from the one before
+			//
+
+			sampleLevels(pEstimator, pool, &sums, dN, C);
+
+			//
+			// Mean, variance and cost per sample.  Deep levels with few
+			// samples can report a mean or variance near zero by chance,
+			// so they are kept from falling far below the decay of the
+			// level before.
+			//
+
+			auto L = sums.size() - 1;
+			std::vector<double> m(L + 1), V(L + 1);
+
+			for (size_t l = 0; l <= L; l++) {
+				if (sums[l].cost <= 0.0)
+					crash(__LINE__, __FILE__, __FUNCTION__, "Level " + std::to_string(l) + " reported no cost");
+
+				m[l] = fabs(sums[l].mean);
+				V[l] = levelVariance(sums[l]);
+				C[l] = sums[l].cost / sums[l].count;
+			}
+
+			for (size_t l = 2; l <= L; l++) {
+				m[l] = std::max(m[l], 0.5 * m[l - 1] / pow(2.0, result.alpha));
+				V[l] = std::max(V[l], 0.5 * V[l - 1] / pow(2.0, result.beta));
+			}
+
+			if (pOptions.alpha <= 0.0)
+				result.alpha = std::max(0.5, -regressionSlope(m));
+
+			if (pOptions.beta <= 0.0)
+				result.beta = std::max(0.5, -regressionSlope(V));
+
+			if (pOptions.gamma <= 0.0)
+				result.gamma = std::max(0.5, regressionSlope(C));
+
+			auto N = optimalSamples(V, C, eps);
+
+			for (size_t l = 0; l <= L; l++)
+				dN[l] = std::max(0.0, N[l] - sums[l].count);
+
+			//
+			// Once the levels are nearly converged, test the bias of the
+			// finest level and add a level if it is too large
+			//
+
+			bool settled = true;
+
+			for (size_t l = 0; l <= L; l++)
+				settled = settled && (dN[l] <= 0.01 * sums[l].count);
+
+			if (!settled)
+				continue;
+
+			double remainder = 0.0;
+
+			for (size_t i = 0; i < 3; i++)
+				remainder = std::max(remainder, m[L - i] / pow(2.0, i * result.alpha));
+
+			remainder /= (pow(2.0, result.alpha) - 1.0);
+
+			if (remainder <= eps / sqrt(2.0))
+				continue;
+
+			if (sums.size() >= pOptions.maxLevels) {
+				result.converged = false;
+				continue;
+			}
+
+			V.push_back(V[L] / pow(2.0, result.beta));
+			C.push_back(C[L] * pow(2.0, result.gamma));
+			sums.push_back(emptyLevel());
+
+			N = optimalSamples(V, C, eps);
+			dN.resize(sums.size());
+
+			for (size_t l = 0; l < sums.size(); l++)
+				dN[l] = std::max(0.0, N[l] - sums[l].count);
+
+		} while (std::any_of(dN.begin(), dN.end(), [](double n) { return n > 0.0; }));
+
+		//
+		// Telescoping sum
+		//
+
+		telescope(&result);
+
+		if (pOptions.stage)
+			pOptions.stage(stage, eps, result);
+	}
+
+	return result;
+}
+
+
+//
+// Function: diagnoseLevels()
+//
+// Parameters:
+//    pLevels - Statistics of levels 0 ... L
+//
+// Returns:
+//    The level table and the measured decay rates
+//
+
+MLMCDiagnostics diagnoseLevels(const std::vector<LevelSums>& pLevels) {
+
+	MLMCDiagnostics diagnostics;
+
+	std::vector<double> m, V, C, seconds;
+
+	for (size_t l = 0; l < pLevels.size(); l++) {
+		auto& sums = pLevels[l];
+		LevelDiagnostics row;
+
+		row.samples = sums.count;
+		row.mean = sums.mean;
+		row.variance = levelVariance(sums);
+		row.meanFine = sums.meanFine;
+		row.varianceFine = (sums.count > 1.0 ? sums.M2Fine / (sums.count - 1.0) : 0.0);
+		row.cost = (sums.count > 0.0 ? sums.cost / sums.count : 0.0);
+		row.seconds = (sums.count > 0.0 ? sums.seconds / sums.count : 0.0);
+		row.kurtosis = (sums.M2 > 0.0 ? sums.count * sums.M4 / (sums.M2 * sums.M2) : 0.0);
+		row.consistency = 0.0;
+
+		if ((l > 0) && (sums.count > 0.0) && (pLevels[l - 1].count > 0.0)) {
+			auto& before = diagnostics.levels[l - 1];
+
+			double error = sqrt(row.variance / row.samples) + sqrt(row.varianceFine / row.samples)
+				+ sqrt(before.varianceFine / before.samples);
+			double difference = fabs(row.mean - row.meanFine + before.meanFine);
+
+			row.consistency = (error > 0.0 ? difference / (3.0 * error) : 0.0);
+		}
+
+		diagnostics.levels.push_back(row);
+
+		m.push_back(fabs(row.mean));
+		V.push_back(row.variance);
+		C.push_back(row.cost);
+		seconds.push_back(row.seconds);
+	}
+
+	diagnostics.alpha = -regressionSlope(m);
+	diagnostics.beta = -regressionSlope(V);
+	diagnostics.gamma = regressionSlope(C);
+	diagnostics.gammaSeconds = regressionSlope(seconds);
+
+	return diagnostics;
+}
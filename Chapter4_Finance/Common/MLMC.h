@@ -0,0 +1,275 @@
+
+/*
+ * Generic multilevel Monte Carlo driver
+ *
+ * A level estimator simulates samples of Y_l = P_l - P_(l-1), the
+ * difference of a fine and a coarse approximation driven by the same
+ * Brownian path (Y_0 = P_0), and reports their cost.  The driver runs
+ * a pilot on the first levels, then repeatedly
+ *
+ *    estimates the mean m_l, variance V_l and cost C_l per sample,
+ *    sets N_l = sqrt(V_l / C_l) sum_k sqrt(V_k C_k) / (eps^2 / 2),
+ *    which splits the mean square error eps^2 equally between the
+ *    sampling variance and the squared bias at minimum total cost,
+ *    estimates the decay rates |m_l| ~ 2^(-alpha l),
+ *    V_l ~ 2^(-beta l) and C_l ~ 2^(gamma l) by regression, and
+ *    adds a level while the bias estimate |m_L| / (2^alpha - 1) is
+ *    above eps / sqrt(2)
+ *
+ * until no level needs more samples.  With continuation the same loop
+ * runs for a decreasing sequence of tolerances, eps r^(S-1) down to
+ * eps, each stage keeping the samples, levels and variance and cost
+ * estimates of the one before (Collier et al. 2015).  Every stage
+ * gives an answer at its tolerance, and the final one costs little
+ * more than a direct run at eps.  Each level addresses its
+ * samples by index, so a run is reproducible and samples added to a
+ * level never repeat the ones it already has.
+ *
+ * The samples owed in a round are cut into chunks of about equal cost,
+ * so a fine level gives few samples per chunk and a coarse level many,
+ * and the chunks of all levels run together on a work stealing pool.
+ * Every chunk writes its own statistics, which are merged in chunk
+ * order once the round is over.  The chunks depend only on the round,
+ * not on the number of threads, so any thread count gives the same
+ * answer.
+ *
+ * See also
+ * Giles, M.B. (2008). "Multilevel Monte Carlo path simulation."
+ * Operations Research, 56(3), pp. 607-617.
+ *
+ * Giles, M.B. (2015). "Multilevel Monte Carlo methods." Acta
+ * Numerica, 24, pp. 259-328.
+ *
+ * Collier, N., Haji-Ali, A.L., Nobile, F., von Schwerin, E.,
+ * Tempone, R. (2015). "A continuation multilevel Monte Carlo
+ * algorithm." BIT Numerical Mathematics, 55(2), pp. 399-432.
+ *
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Levels sampled in cost weighted chunks on a
+ *                     work stealing pool
+ *
+ * 2026-10-19  JJL     optimalSamples() and sampleLevels() shared with
+ *                     the multi-index driver
+ *
+ * 2026-10-19  JJL     regressionSlope() shared with the quasi-Monte
+ *                     Carlo driver
+ *
+ * 2026-10-19  JJL     Third and fourth moments and wall time of each
+ *                     level, diagnoseLevels() for the level table
+ *
+ * 2026-10-19  JJL     Continuation over a decreasing sequence of
+ *                     tolerances
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <functional>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Definitions
+//
+
+#define _MLMC_Pilot_Samples_   1000
+#define _MLMC_Min_Levels_      3
+#define _MLMC_Max_Levels_      10
+
+// Chunks a round is cut into, whatever the number of threads
+#define _MLMC_Round_Chunks_    256
+
+// Tolerance ratio between continuation stages
+#define _MLMC_Stage_Ratio_     2.0
+
+
+class WorkStealingPool;
+
+
+//
+// Structure: LevelSums
+//
+// Description:
+//    Running statistics of one level.  mean, M2, M3 and M4 are over
+//    Y_l, the fine minus coarse samples, and meanFine and M2Fine over
+//    P_l.  cost is the total cost of the samples in the estimator's
+//    units and seconds the wall time the driver measured for them.
+//
+
+struct LevelSums {
+	double count;
+	double mean;
+	double M2;
+	double M3;
+	double M4;
+	double meanFine;
+	double M2Fine;
+	double cost;
+	double seconds;
+};
+
+
+//
+// Type: LevelEstimator
+//
+// Parameters:
+//    pLevel - Level to sample
+//    pFirst - Index of the first sample, samples are addressed by index
+//    pCount - Number of samples
+//
+// Returns:
+//    Statistics of samples pFirst ... pFirst + pCount - 1 of the level
+//
+// Comments:
+//    Called concurrently from the threads of the pool
+//
+
+typedef std::function<LevelSums(unsigned int pLevel, uint64_t pFirst, uint64_t pCount)> LevelEstimator;
+
+
+//
+// Type: StageObserver
+//
+// Parameters:
+//    pStage - Continuation stage, 0 ... stages - 1
+//    peps - Tolerance of the stage
+//    pResult - Result at that tolerance
+//
+
+struct MLMCResult;
+
+typedef std::function<void(unsigned int pStage, double peps, const MLMCResult& pResult)> StageObserver;
+
+
+//
+// Structure: MLMCOptions
+//
+// Description:
+//    alpha, beta and gamma of 0 are estimated from the levels,
+//    positive values are used as given.  threads of 0 is one per core.
+//    stages above 1 run continuation with tolerances stageRatio apart,
+//    and stage, if set, is called with the result of every stage.
+//
+
+struct MLMCOptions {
+	double eps;
+	uint64_t pilot = _MLMC_Pilot_Samples_;
+	unsigned int minLevels = _MLMC_Min_Levels_;
+	unsigned int maxLevels = _MLMC_Max_Levels_;
+	double alpha = 0.0;
+	double beta = 0.0;
+	double gamma = 0.0;
+	unsigned int threads = 0;
+	unsigned int stages = 1;
+	double stageRatio = _MLMC_Stage_Ratio_;
+	StageObserver stage;
+};
+
+
+//
+// Structure: MLMCResult
+//
+
+struct MLMCResult {
+	double estimate;
+	double variance;       // Variance of the estimate, sum V_l / N_l
+	double cost;
+	double alpha;
+	double beta;
+	double gamma;
+	bool converged;        // False when maxLevels was reached with the bias above target
+	std::vector<LevelSums> levels;
+};
+
+
+//
+// Structure: LevelDiagnostics
+//
+// Description:
+//    One row of the level table.  consistency is
+//    |E[Y_l] - E[P_l] + E[P_(l-1)]| over three times its standard
+//    error, the check of Giles (2015).  The coarse path of level l and
+//    the fine path of level l - 1 must have the same mean, so a value
+//    above 1 points at a coupling bug.  A kurtosis in the hundreds
+//    means the variance of Y_l rests on rare samples and is not to be
+//    trusted.
+//
+
+struct LevelDiagnostics {
+	double samples;
+	double mean;
+	double variance;
+	double meanFine;
+	double varianceFine;
+	double cost;           // Per sample, estimator units
+	double seconds;        // Per sample, wall time
+	double kurtosis;
+	double consistency;    // 0 on level 0
+};
+
+
+//
+// Structure: MLMCDiagnostics
+//
+// Description:
+//    Level table with alpha, beta and gamma regressed on the levels
+//    l >= 1 as measured, without the clamps and corrections the driver
+//    applies.  gammaSeconds is gamma of the wall time.
+//
+
+struct MLMCDiagnostics {
+	std::vector<LevelDiagnostics> levels;
+	double alpha;
+	double beta;
+	double gamma;
+	double gammaSeconds;
+};
+
+
+//
+// Function prototypes
+//
+
+LevelSums emptyLevel();
+
+void accumulateLevel(LevelSums* pLevel, double pFine, double pCoarse);
+
+void mergeLevel(LevelSums* pTotal, const LevelSums& pLevel);
+
+double levelVariance(const LevelSums& pLevel);
+
+double regressionSlope(const std::vector<double>& pValues);
+
+std::vector<double> optimalSamples(const std::vector<double>& pV,
+	const std::vector<double>& pC, double peps);
+
+void sampleLevels(const LevelEstimator& pEstimator, WorkStealingPool& pPool,
+	std::vector<LevelSums>* pSums, const std::vector<double>& pdN, const std::vector<double>& pC);
+
+MLMCResult multilevelMonteCarlo(const LevelEstimator& pEstimator, const MLMCOptions& pOptions);
+
+MLMCDiagnostics diagnoseLevels(const std::vector<LevelSums>& pLevels);
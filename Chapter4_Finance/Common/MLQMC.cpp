@@ -0,0 +1,212 @@
+
+/*
+ * Multilevel quasi-Monte Carlo driver
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     maxLevels below minLevels runs the levels it
+ *                     allows and reports no convergence
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/MLQMC.h"
+#include "../Common/WorkStealing.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <algorithm>
+#include <math.h>
+#include <string>
+
+
+//
+// Function: multilevelQuasiMonteCarlo()
+//
+// Parameters:
+//    pEstimator - Sampler of the randomized point sets of each level
+//    pOptions - Target RMSE, level limits, threads and a known alpha.
+//               pilot, beta, gamma and the continuation stages are
+//               not used.
+//
+// Returns:
+//    Estimate of E[P_L].  variance is the variance of the estimate from
+//    the spread of the randomizations, levels holds the statistics of
+//    every level over all its points and beta their decay.
+//
+
+MLMCResult multilevelQuasiMonteCarlo(const QuasiLevelEstimator& pEstimator, const MLMCOptions& pOptions) {
+
+	if (pOptions.eps <= 0.0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Target RMSE must be positive");
+
+	if ((pOptions.minLevels < 3) || (pOptions.maxLevels < 1))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Invalid MLQMC options: levels "
+			+ std::to_string(pOptions.minLevels) + " to " + std::to_string(pOptions.maxLevels));
+
+	const unsigned int R = _MLQMC_Randomizations_;
+
+	MLMCResult result;
+	result.alpha = std::max(0.0, pOptions.alpha);
+	result.converged = true;
+
+	// Points per randomization of each level, fewer levels than the
+	// bias test needs when maxLevels is below minLevels
+	std::vector<double> N(std::min(pOptions.minLevels, pOptions.maxLevels),
+		static_cast<double>(_MLQMC_Initial_Points_));
+
+	// Statistics and cost per point of each (level, randomization)
+	std::vector<LevelSums> sums(N.size() * R, emptyLevel());
+	std::vector<double> C(N.size());
+
+	for (size_t l = 0; l < C.size(); l++)
+		C[l] = pow(2.0, static_cast<double>(l));
+
+	// The sampling rounds of the MLMC driver, one task list entry per set
+	auto estimator = [&](unsigned int pid, uint64_t pfirst, uint64_t pcount) {
+		return pEstimator(pid / R, pid % R, pfirst, pcount);
+	};
+
+	WorkStealingPool pool(pOptions.threads);
+
+	std::vector<double> m, V;
+
+	for (;;) {
+		auto levels = N.size();
+
+		std::vector<double> dN(levels * R), CR(levels * R);
+
+		for (size_t id = 0; id < dN.size(); id++) {
+			dN[id] = std::max(0.0, N[id / R] - sums[id].count);
+			CR[id] = C[id / R];
+		}
+
+		sampleLevels(estimator, pool, &sums, dN, CR);
+
+		//
+		// Mean of the randomizations and the variance of that mean
+		//
+
+		m.assign(levels, 0.0);
+		V.assign(levels, 0.0);
+
+		for (size_t l = 0; l < levels; l++) {
+			double cost = 0.0, count = 0.0;
+
+			for (unsigned int r = 0; r < R; r++) {
+				m[l] += sums[l * R + r].mean / R;
+				cost += sums[l * R + r].cost;
+				count += sums[l * R + r].count;
+			}
+
+			for (unsigned int r = 0; r < R; r++)
+				V[l] += pow(sums[l * R + r].mean - m[l], 2.0) / (R * (R - 1.0));
+
+			if (cost <= 0.0)
+				crash(__LINE__, __FILE__, __FUNCTION__, "Level " + std::to_string(l) + " reported no cost");
+
+			C[l] = cost / count;
+			m[l] = fabs(m[l]);
+		}
+
+		for (size_t l = 2; l < levels; l++)
+			m[l] = std::max(m[l], 0.5 * m[l - 1] / pow(2.0, result.alpha));
+
+		if (pOptions.alpha <= 0.0)
+			result.alpha = std::max(0.5, -regressionSlope(m));
+
+		//
+		// Double the points where they remove the most variance per
+		// unit of cost
+		//
+
+		double total = 0.0;
+
+		for (auto v : V)
+			total += v;
+
+		if (total > 0.5 * pOptions.eps * pOptions.eps) {
+			size_t best = 0;
+
+			for (size_t l = 1; l < levels; l++)
+				if (V[l] / (C[l] * N[l]) > V[best] / (C[best] * N[best]))
+					best = l;
+
+			N[best] *= 2.0;
+			continue;
+		}
+
+		//
+		// Bias of the finest level as in the MLMC driver
+		//
+
+		auto L = levels - 1;
+
+		if (levels >= 3) {
+			double remainder = 0.0;
+
+			for (size_t i = 0; i < 3; i++)
+				remainder = std::max(remainder, m[L - i] / pow(2.0, i * result.alpha));
+
+			remainder /= (pow(2.0, result.alpha) - 1.0);
+
+			if (remainder <= pOptions.eps / sqrt(2.0))
+				break;
+		}
+
+		if (levels >= pOptions.maxLevels) {
+			result.converged = false;
+			break;
+		}
+
+		N.push_back(static_cast<double>(_MLQMC_Initial_Points_));
+		C.push_back(2.0 * C[L]);
+		sums.resize(N.size() * R, emptyLevel());
+	}
+
+	//
+	// Telescoping sum
+	//
+
+	result.estimate = 0.0;
+	result.variance = 0.0;
+	result.cost = 0.0;
+	result.levels.assign(N.size(), emptyLevel());
+
+	std::vector<double> perPoint(N.size()), cost(N.size());
+
+	for (size_t l = 0; l < N.size(); l++) {
+		double mean = 0.0;
+
+		for (unsigned int r = 0; r < R; r++) {
+			mean += sums[l * R + r].mean / R;
+			mergeLevel(&result.levels[l], sums[l * R + r]);
+		}
+
+		result.estimate += mean;
+		result.variance += V[l];
+		result.cost += result.levels[l].cost;
+
+		perPoint[l] = levelVariance(result.levels[l]);
+		cost[l] = result.levels[l].cost / result.levels[l].count;
+	}
+
+	result.beta = std::max(0.0, -regressionSlope(perPoint));
+	result.gamma = std::max(0.0, regressionSlope(cost));
+
+	return result;
+}
@@ -0,0 +1,94 @@
+
+/*
+ * Multilevel quasi-Monte Carlo driver
+ *
+ * Every level is sampled with R independently randomized Sobol point
+ * sets of N_l points each.  The mean of each set is an unbiased
+ * estimate of E[Y_l], and the spread of the R means gives the variance
+ * of their average,
+ *
+ *    V_l = sum_r (mean_r - mean)^2 / (R (R - 1))
+ *
+ * which falls faster than 1 / N_l when the integrand is smooth enough
+ * for the points to pay off.  Starting from a few points on the first
+ * levels the driver repeatedly
+ *
+ *    doubles N_l on the level with the largest V_l / (C_l N_l), the
+ *    most variance removed per unit of cost, while sum V_l is above
+ *    eps^2 / 2, and
+ *    adds a level while the bias estimate of the MLMC driver is above
+ *    eps / sqrt(2)
+ *
+ * N_l stays a power of two, so every point set is a complete net.
+ * Points are addressed by (level, randomization, index) and sampled in
+ * the cost weighted rounds of the MLMC driver, so the answer does not
+ * depend on the number of threads.
+ *
+ * See also
+ * Giles, M.B., Waterhouse, B.J. (2009). "Multilevel quasi-Monte Carlo
+ * path simulation." Radon Series on Computational and Applied
+ * Mathematics, 8, pp. 165-181.
+ *
+ * Owen, A.B. (1997). "Scrambled net variance for integrals of smooth
+ * functions." The Annals of Statistics, 25(4), pp. 1541-1562.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Local Includes
+//
+
+#include "../Common/MLMC.h"
+
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <functional>
+
+
+//
+// Definitions
+//
+
+#define _MLQMC_Randomizations_   32
+#define _MLQMC_Initial_Points_   16
+
+
+//
+// Type: QuasiLevelEstimator
+//
+// Parameters:
+//    pLevel - Level to sample
+//    pRandomization - Randomized point set, 0 ... R - 1
+//    pFirst - Index of the first point of the set
+//    pCount - Number of points
+//
+// Returns:
+//    Statistics of points pFirst ... pFirst + pCount - 1 of the set
+//
+// Comments:
+//    Called concurrently from the threads of the pool
+//
+
+typedef std::function<LevelSums(unsigned int pLevel, unsigned int pRandomization,
+	uint64_t pFirst, uint64_t pCount)> QuasiLevelEstimator;
+
+
+//
+// Function prototypes
+//
+
+MLMCResult multilevelQuasiMonteCarlo(const QuasiLevelEstimator& pEstimator, const MLMCOptions& pOptions);
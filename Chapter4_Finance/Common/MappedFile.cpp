@@ -0,0 +1,134 @@
+
+/*
+ * Read-only memory mapped file
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version, taken out of RawData
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/MappedFile.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+//
+// Function: MappedFile()
+//
+// Parameters:
+//    pFilename - File to map, crashes if it cannot be opened
+//
+
+MappedFile::MappedFile(std::string pFilename) :
+	memory(nullptr), length(0), mapped(false) {
+
+#ifdef __linux__
+	int fd = open(pFilename.c_str(), O_RDONLY);
+
+	if (fd < 0) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	struct stat status;
+
+	if (fstat(fd, &status) != 0) {
+		close(fd);
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to stat " + pFilename);
+	}
+
+	length = static_cast<size_t>(status.st_size);
+
+	if (length > 0) {
+		void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (address == MAP_FAILED) {
+			close(fd);
+			crash(__LINE__, __FILE__, __FUNCTION__, "Unable to map " + pFilename);
+		}
+
+		madvise(address, length, MADV_WILLNEED);
+
+		memory = static_cast<const char*>(address);
+		mapped = true;
+	}
+
+	close(fd);
+#else
+	std::ifstream inFile(pFilename, std::ios::in | std::ios::binary);
+
+	if (!inFile.is_open()) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	std::ostringstream contents;
+	contents << inFile.rdbuf();
+	buffer = contents.str();
+
+	memory = buffer.data();
+	length = buffer.size();
+#endif
+}
+
+
+MappedFile::~MappedFile() {
+#ifdef __linux__
+	if (mapped)
+		munmap(const_cast<char*>(memory), length);
+#endif
+}
+
+
+//
+// Function: fileStamp()
+//
+// Parameters:
+//    pFilename - Any file
+//    pSize - Size in bytes, written
+//    pModified - Modification time in nanoseconds, written
+//
+// Returns:
+//    true if the file exists
+//
+
+bool fileStamp(std::string pFilename, uint64_t* pSize, uint64_t* pModified) {
+
+	struct stat status;
+
+	if (stat(pFilename.c_str(), &status) != 0)
+		return false;
+
+	*pSize = static_cast<uint64_t>(status.st_size);
+
+#ifdef __linux__
+	*pModified = static_cast<uint64_t>(status.st_mtim.tv_sec) * 1000000000ULL
+		+ static_cast<uint64_t>(status.st_mtim.tv_nsec);
+#else
+	*pModified = static_cast<uint64_t>(status.st_mtime) * 1000000000ULL;
+#endif
+
+	return true;
+}
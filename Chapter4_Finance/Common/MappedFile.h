@@ -0,0 +1,65 @@
+
+/*
+ * Read-only memory mapped file
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version, taken out of RawData
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+//
+// Class: MappedFile
+//
+// Description:
+//    Maps a whole file read-only.  Platforms without mmap read the
+//    file into a single buffer instead.  An empty file has no data.
+//
+
+class MappedFile {
+public:
+	MappedFile(std::string pFilename);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* data() const { return memory; }
+	size_t size() const { return length; }
+
+private:
+	const char* memory;
+	size_t length;
+	bool mapped;
+	std::string buffer;
+};
+
+
+//
+// Function: fileStamp()
+//
+// Parameters:
+//    pFilename - Any file
+//    pSize - Size in bytes, written
+//    pModified - Modification time in nanoseconds, written
+//
+// Returns:
+//    true if the file exists
+//
+
+bool fileStamp(std::string pFilename, uint64_t* pSize, uint64_t* pModified);
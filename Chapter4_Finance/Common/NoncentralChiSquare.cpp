@@ -0,0 +1,478 @@
+
+/*
+ * Tabulated inverse of the noncentral chi-square distribution
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Tables cached in NCX2_CACHE_DIR or /tmp instead
+ *                     of the working directory
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/NoncentralChiSquare.h"
+#include "../Common/Crash.h"
+#include "../Common/Log.h"
+
+
+//
+// Standard Includes
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <math.h>
+
+
+//
+// STL Includes
+//
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+//
+// Definitions
+//
+
+#define _NCX2_Tolerance_      1.0e-17
+#define _NCX2_Bisections_     200
+
+
+//
+// Function: regularizedGamma()
+//
+// Parameters:
+//    pa - Shape, positive
+//    py - Argument, positive
+//
+// Returns:
+//    P(a, y), by its series below a + 1 and the continued fraction of
+//    Q(a, y) above
+//
+
+static double regularizedGamma(double pa, double py) {
+
+	double front = exp(pa * log(py) - py - lgamma(pa));
+
+	if (py < pa + 1.0) {
+		double term = 1.0 / pa;
+		double sum = term;
+
+		for (auto n = 1; n < 100000; n++) {
+			term *= py / (pa + n);
+			sum += term;
+
+			if (term < sum * 1e-17)
+				break;
+		}
+
+		return std::min(1.0, sum * front);
+	}
+
+	// Modified Lentz
+	double b = py + 1.0 - pa;
+	double c = 1.0 / 1e-300;
+	double d = 1.0 / b;
+	double h = d;
+
+	for (auto n = 1; n < 100000; n++) {
+		double an = -n * (n - pa);
+		b += 2.0;
+		d = an * d + b;
+		d = (fabs(d) < 1e-300 ? 1e-300 : d);
+		c = b + an / c;
+		c = (fabs(c) < 1e-300 ? 1e-300 : c);
+		d = 1.0 / d;
+		double delta = d * c;
+		h *= delta;
+
+		if (fabs(delta - 1.0) < 1e-16)
+			break;
+	}
+
+	return std::max(0.0, 1.0 - front * h);
+}
+
+
+//
+// Function: noncentralChiSquareCDF()
+//
+// Parameters:
+//    pX - Argument
+//    pDegrees - Degrees of freedom d, positive
+//    pLambda - Noncentrality, non-negative
+//
+// Returns:
+//    P(Y <= x) = sum_j Poisson(j; lambda / 2) P(d / 2 + j, x / 2).  The
+//    sum starts at the mode of the Poisson weights and runs out both
+//    ways, stepping P(a, y) with P(a + 1, y) = P(a, y) - g(a), where
+//    g(a) = y^a e^(-y) / Gamma(a + 1), until the terms are negligible.
+//
+
+double noncentralChiSquareCDF(double pX, double pDegrees, double pLambda) {
+
+	if (pX <= 0.0)
+		return 0.0;
+
+	double y = 0.5 * pX;
+	double half = 0.5 * pLambda;
+	double a0 = 0.5 * pDegrees;
+
+	if (half <= 0.0)
+		return regularizedGamma(a0, y);
+
+	double mode = floor(half);
+	double am = a0 + mode;
+
+	double poisson = exp(-half + mode * log(half) - lgamma(mode + 1.0));
+	double Pm = regularizedGamma(am, y);
+	double gm = exp(am * log(y) - y - lgamma(am + 1.0));
+	double sum = poisson * Pm;
+
+	// Upward from the mode
+	double p = poisson, P = Pm, g = gm;
+
+	for (double j = mode + 1.0; ; j += 1.0) {
+		double a = a0 + j - 1.0;
+
+		P = std::max(0.0, P - g);
+		g *= y / (a + 1.0);
+		p *= half / j;
+
+		double term = p * P;
+		sum += term;
+
+		if ((p < _NCX2_Tolerance_) || (term < sum * _NCX2_Tolerance_))
+			break;
+	}
+
+	// Downward from the mode, P grows back towards P(a0, y)
+	p = poisson;
+	P = Pm;
+	g = gm * am / y;
+
+	for (double j = mode - 1.0; j >= 0.0; j -= 1.0) {
+		double a = a0 + j;
+
+		P = std::min(1.0, P + g);
+		p *= (j + 1.0) / half;
+		g *= a / y;
+
+		sum += p * P;
+
+		if (p < _NCX2_Tolerance_)
+			break;
+	}
+
+	return std::min(1.0, sum);
+}
+
+
+//
+// Function: standardQuantile()
+//
+// Parameters:
+//    pDegrees, pLambda - Distribution
+//    pZ - Normal quantile of the probability
+//
+// Returns:
+//    Quantile at Phi(z) by bisection, standardized by the mean and
+//    standard deviation
+//
+
+static double standardQuantile(double pDegrees, double pLambda, double pZ) {
+
+	double mean = pDegrees + pLambda;
+	double sd = sqrt(2.0 * (pDegrees + 2.0 * pLambda));
+	double target = 0.5 * erfc(-pZ * M_SQRT1_2);
+
+	double lo = std::max(0.0, mean + sd * (pZ - 2.0));
+	double hi = mean + sd * (pZ + 2.0);
+
+	while ((lo > 0.0) && (noncentralChiSquareCDF(lo, pDegrees, pLambda) > target))
+		lo = std::max(0.0, lo - 2.0 * sd);
+
+	while (noncentralChiSquareCDF(hi, pDegrees, pLambda) < target)
+		hi += 2.0 * sd;
+
+	for (auto i = 0; i < _NCX2_Bisections_; i++) {
+		double mid = 0.5 * (lo + hi);
+
+		if ((mid <= lo) || (mid >= hi))
+			break;
+
+		if (noncentralChiSquareCDF(mid, pDegrees, pLambda) < target)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return (0.5 * (lo + hi) - mean) / sd;
+}
+
+
+//
+// Function: rowLambda()
+//
+// Returns:
+//    Noncentrality of finite row k, uniform in u up to maxU
+//
+
+static double rowLambda(unsigned int pRow, double pMaxU) {
+
+	double u = pMaxU * pRow / (_NCX2_Rows_ - 1);
+	double s = _NCX2_Scale_ * u / (1.0 - u);
+
+	return s * s;
+}
+
+
+//
+// Function: NoncentralChiSquareTable()
+//
+// Parameters:
+//    pDegrees - Degrees of freedom d, positive
+//
+
+NoncentralChiSquareTable::NoncentralChiSquareTable(double pDegrees) :
+	d(pDegrees), w(static_cast<size_t>(_NCX2_Rows_ + 1) * _NCX2_Normals_) {
+
+	if (!(d > 0.0) || !isfinite(d))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Degrees of freedom must be positive, got " + std::to_string(d));
+
+	double s = sqrt(_NCX2_Max_Lambda_);
+	maxU = s / (s + _NCX2_Scale_);
+
+	uint64_t bits;
+	std::memcpy(&bits, &d, sizeof(bits));
+
+	char name[64];
+	snprintf(name, sizeof(name), "ncx2.%016llx.bin", static_cast<unsigned long long>(bits));
+
+	auto directory = getenv("NCX2_CACHE_DIR");
+	std::string filename = std::string((directory != nullptr) && (*directory != '\0') ? directory
+		: _NCX2_Cache_Dir_) + "/" + name;
+
+	if (load(filename))
+		return;
+
+	build();
+	save(filename);
+}
+
+
+//
+// Function: build()
+//
+
+void NoncentralChiSquareTable::build() {
+
+	double dz = 2.0 * _NCX2_Max_Normal_ / (_NCX2_Normals_ - 1);
+
+	for (auto k = 0u; k < _NCX2_Rows_; k++) {
+		double lambda = rowLambda(k, maxU);
+
+		for (auto j = 0u; j < _NCX2_Normals_; j++)
+			w[k * _NCX2_Normals_ + j] = standardQuantile(d, lambda, -_NCX2_Max_Normal_ + j * dz);
+	}
+
+	// Normal limit as lambda grows
+	for (auto j = 0u; j < _NCX2_Normals_; j++)
+		w[_NCX2_Rows_ * _NCX2_Normals_ + j] = -_NCX2_Max_Normal_ + j * dz;
+
+	LogLine(_LOG_INFO_, "Built noncentral chi-square table").field("degrees", d);
+}
+
+
+//
+// Function: load()
+//
+// Returns:
+//    True if pFilename holds the table of this d and layout
+//
+
+bool NoncentralChiSquareTable::load(std::string pFilename) {
+
+	std::ifstream inFile(pFilename, std::ios::in | std::ios::binary);
+
+	if (!inFile.is_open())
+		return false;
+
+	NoncentralHeader header;
+
+	inFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	if (!inFile.good() || (header.magic != _NCX2_Magic_) || (header.version != _NCX2_Version_)
+		|| (header.degrees != d) || (header.rows != _NCX2_Rows_) || (header.normals != _NCX2_Normals_)
+		|| (header.maxNormal != _NCX2_Max_Normal_) || (header.maxLambda != _NCX2_Max_Lambda_)
+		|| (header.scale != _NCX2_Scale_))
+		return false;
+
+	inFile.read(reinterpret_cast<char*>(w.data()), w.size() * sizeof(double));
+
+	return inFile.good();
+}
+
+
+//
+// Function: save()
+//
+// Description:
+//    Written beside the target and renamed, as the parameter sidecar.
+//    Failing to write it only costs the next run a rebuild.
+//
+
+void NoncentralChiSquareTable::save(std::string pFilename) const {
+
+	NoncentralHeader header = {};
+	header.magic = _NCX2_Magic_;
+	header.version = _NCX2_Version_;
+	header.degrees = d;
+	header.rows = _NCX2_Rows_;
+	header.normals = _NCX2_Normals_;
+	header.maxNormal = _NCX2_Max_Normal_;
+	header.maxLambda = _NCX2_Max_Lambda_;
+	header.scale = _NCX2_Scale_;
+
+	std::string temporary = pFilename + ".tmp";
+
+	{
+		std::ofstream outFile(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (outFile.is_open()) {
+			outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			outFile.write(reinterpret_cast<const char*>(w.data()), w.size() * sizeof(double));
+		}
+
+		if (!outFile.is_open() || !outFile.good()) {
+			LogLine(_LOG_WARN_, "Unable to write noncentral chi-square table").field("file", pFilename);
+			std::remove(temporary.c_str());
+			return;
+		}
+	}
+
+	if (std::rename(temporary.c_str(), pFilename.c_str()) != 0) {
+		LogLine(_LOG_WARN_, "Unable to replace noncentral chi-square table").field("file", pFilename);
+		std::remove(temporary.c_str());
+	}
+}
+
+
+//
+// Function: quantile()
+//
+// Parameters:
+//    pLambda - Noncentrality, non-negative
+//    pZ - Standard normal draw
+//
+// Returns:
+//    Noncentral chi-square quantile at Phi(z), never negative.  z
+//    beyond the grid is extrapolated linearly from its last interval.
+//
+
+double NoncentralChiSquareTable::quantile(double pLambda, double pZ) const {
+
+	double lambda = std::max(0.0, pLambda);
+	double s = sqrt(lambda);
+	double u = s / (s + _NCX2_Scale_);
+
+	unsigned int k;
+	double fu;
+
+	if (u < maxU) {
+		double position = u / maxU * (_NCX2_Rows_ - 1);
+		k = std::min(static_cast<unsigned int>(position), static_cast<unsigned int>(_NCX2_Rows_ - 2));
+		fu = position - k;
+	}
+	else {
+		k = _NCX2_Rows_ - 1;
+		fu = (u - maxU) / (1.0 - maxU);
+	}
+
+	double position = (pZ + _NCX2_Max_Normal_) * ((_NCX2_Normals_ - 1) / (2.0 * _NCX2_Max_Normal_));
+	double j = std::min(std::max(floor(position), 0.0), static_cast<double>(_NCX2_Normals_ - 2));
+	double fz = position - j;
+
+	auto row = &w[k * _NCX2_Normals_ + static_cast<size_t>(j)];
+	auto next = row + _NCX2_Normals_;
+
+	double low = row[0] + fz * (row[1] - row[0]);
+	double high = next[0] + fz * (next[1] - next[0]);
+	double standard = low + fu * (high - low);
+
+	return std::max(0.0, lambda + d + sqrt(2.0 * (d + 2.0 * lambda)) * standard);
+}
+
+
+//
+// Structure: TableRegistry
+//
+// Description:
+//    Tables built so far, keyed by the bits of d.  They live until the
+//    program exits, so references handed out stay valid.
+//
+
+struct TableRegistry {
+	std::mutex lock;
+	std::map<uint64_t, std::unique_ptr<NoncentralChiSquareTable>> tables;
+};
+
+static TableRegistry tableRegistry;
+
+
+//
+// Function: forDegrees()
+//
+// Parameters:
+//    pDegrees - Degrees of freedom d
+//
+// Returns:
+//    The table of d, loaded or built on first use.  A path asks every
+//    step, so each thread remembers the last tables it was given.
+//
+
+const NoncentralChiSquareTable& NoncentralChiSquareTable::forDegrees(double pDegrees) {
+
+	thread_local const NoncentralChiSquareTable* recent[2] = { nullptr, nullptr };
+
+	for (auto table : recent)
+		if ((table != nullptr) && (table->d == pDegrees))
+			return *table;
+
+	uint64_t bits;
+	std::memcpy(&bits, &pDegrees, sizeof(bits));
+
+	const NoncentralChiSquareTable* table;
+
+	{
+		std::lock_guard<std::mutex> guard(tableRegistry.lock);
+
+		auto& entry = tableRegistry.tables[bits];
+
+		if (!entry)
+			entry.reset(new NoncentralChiSquareTable(pDegrees));
+
+		table = entry.get();
+	}
+
+	recent[1] = recent[0];
+	recent[0] = table;
+
+	return *table;
+}
@@ -0,0 +1,141 @@
+
+/*
+ * Tabulated inverse of the noncentral chi-square distribution
+ *
+ * Over a step dt the square root process
+ *
+ *    dx = kappa (theta - x) dt + xi sqrt(x) dW
+ *
+ * moves to c Y, where Y is noncentral chi-square with d = 4 kappa
+ * theta / xi^2 degrees of freedom and noncentrality lambda =
+ * x exp(-kappa dt) / c, and c = xi^2 (1 - exp(-kappa dt)) / (4 kappa).
+ * d depends only on the parameters, so one table per d serves every
+ * step size and state.  It holds the quantile at Phi(z) on a grid of
+ * z and of u = sqrt(lambda) / (sqrt(lambda) + 4), standardized as
+ *
+ *    w = (quantile - (d + lambda)) / sqrt(2 (d + 2 lambda))
+ *
+ * which is smooth in both and tends to z as lambda grows, the last row
+ * of the table.  A draw is a bilinear interpolation.
+ *
+ * The quantiles come from the Poisson mixture of central chi-square
+ * distribution functions, summed out from the mode of the Poisson
+ * weights with the recurrence of the regularized incomplete gamma
+ * function, and inverted by bisection.  A table takes a second or so
+ * to build, so it is written to ncx2.<d>.bin and read back by later
+ * runs.  The tables go in the directory named by the environment
+ * variable NCX2_CACHE_DIR, or in _NCX2_Cache_Dir_ when it is not set,
+ * so runs from any working directory share them.
+ *
+ * See also
+ * Glasserman, P. (2003). "Monte Carlo Methods in Financial
+ * Engineering." Springer, section 3.4.
+ *
+ * Benton, D., Krishnamoorthy, K. (2003). "Computing discrete mixtures
+ * of continuous distributions: noncentral chisquare, noncentral t and
+ * the distribution of the square of the sample multiple correlation
+ * coefficient." Computational Statistics & Data Analysis, 43(2),
+ * pp. 249-267.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Tables cached in NCX2_CACHE_DIR or /tmp instead
+ *                     of the working directory
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Definitions
+//
+
+#define _NCX2_Magic_          0x3258434E424154ULL
+#define _NCX2_Version_        1
+
+// Cache directory when NCX2_CACHE_DIR is not set
+#ifndef _NCX2_Cache_Dir_
+#define _NCX2_Cache_Dir_      "/tmp"
+#endif
+
+// z grid over [-_NCX2_Max_Normal_, _NCX2_Max_Normal_], extrapolated beyond
+#define _NCX2_Normals_        101
+#define _NCX2_Max_Normal_     5.0
+
+// u grid up to lambda = _NCX2_Max_Lambda_, then the normal limit
+#define _NCX2_Rows_           129
+#define _NCX2_Max_Lambda_     1.0e4
+#define _NCX2_Scale_          4.0
+
+
+//
+// Structure: NoncentralHeader
+//
+// Description:
+//    Start of a cached table, followed by rows + 1 rows of normals
+//    doubles
+//
+
+struct NoncentralHeader {
+	uint64_t magic;
+	uint64_t version;
+	double degrees;
+	uint64_t rows;
+	uint64_t normals;
+	double maxNormal;
+	double maxLambda;
+	double scale;
+};
+
+
+//
+// Class: NoncentralChiSquareTable
+//
+
+class NoncentralChiSquareTable {
+public:
+	NoncentralChiSquareTable(double pDegrees);
+
+	static const NoncentralChiSquareTable& forDegrees(double pDegrees);
+
+	double degrees() const { return d; }
+
+	double quantile(double pLambda, double pZ) const;
+
+private:
+	bool load(std::string pFilename);
+	void save(std::string pFilename) const;
+	void build();
+
+	double d;
+	double maxU;
+	std::vector<double> w;   // Row major, rows + 1 rows of normals
+};
+
+
+//
+// Function prototypes
+//
+
+double noncentralChiSquareCDF(double pX, double pDegrees, double pLambda);
@@ -0,0 +1,495 @@
+
+/*
+ * Typed parameter sweep table
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version, replaces importParameters()
+ *
+ * 2026-10-19  JJL     Row walk moved to ParameterReader so rows can
+ *                     be streamed without building the table
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/ParameterTable.h"
+#include "../Common/parseRow.h"
+#include "../Common/Crash.h"
+#include "../Common/Log.h"
+
+
+//
+// Standard Includes
+//
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <math.h>
+
+
+//
+// Column names, indexed by the Parameters.h slots
+//
+
+static const char* parameterNames[_Number_Of_Parameters_] =
+	{ "K", "T", "v", "Kv", "sigmav", "rho12", "ClosedForm" };
+
+
+//
+// Class: ExpressionParser
+//
+// Description:
+//    Recursive descent over
+//       expression := term { (+|-) term }
+//       term       := factor { (*|/) factor }
+//       factor     := (+|-) factor | number | ( expression )
+//
+
+class ExpressionParser {
+public:
+	ExpressionParser(std::string_view pText) : text(pText), position(0) {}
+
+	bool evaluate(double* pValue) {
+		if (!expression(pValue))
+			return false;
+
+		skipSpace();
+
+		return (position == text.size());
+	}
+
+private:
+	void skipSpace() {
+		while ((position < text.size()) && ((text[position] == ' ') || (text[position] == '\t')))
+			position++;
+	}
+
+	bool accept(char pCharacter) {
+		skipSpace();
+
+		if ((position < text.size()) && (text[position] == pCharacter)) {
+			position++;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool expression(double* pValue) {
+		if (!term(pValue))
+			return false;
+
+		for (;;) {
+			double right = 0.0;
+
+			if (accept('+')) {
+				if (!term(&right))
+					return false;
+
+				*pValue += right;
+			}
+			else if (accept('-')) {
+				if (!term(&right))
+					return false;
+
+				*pValue -= right;
+			}
+			else
+				return true;
+		}
+	}
+
+	bool term(double* pValue) {
+		if (!factor(pValue))
+			return false;
+
+		for (;;) {
+			double right = 0.0;
+
+			if (accept('*')) {
+				if (!factor(&right))
+					return false;
+
+				*pValue *= right;
+			}
+			else if (accept('/')) {
+				if (!factor(&right))
+					return false;
+
+				*pValue /= right;
+			}
+			else
+				return true;
+		}
+	}
+
+	bool factor(double* pValue) {
+		if (accept('+'))
+			return factor(pValue);
+
+		if (accept('-')) {
+			if (!factor(pValue))
+				return false;
+
+			*pValue = -*pValue;
+			return true;
+		}
+
+		if (accept('('))
+			return expression(pValue) && accept(')');
+
+		skipSpace();
+
+		// A number must start with a digit or a point, which keeps
+		// from_chars from accepting inf and nan
+		if ((position >= text.size()) ||
+			!(isdigit(static_cast<unsigned char>(text[position])) || (text[position] == '.')))
+			return false;
+
+		auto result = std::from_chars(text.data() + position, text.data() + text.size(), *pValue);
+
+		if (result.ec != std::errc())
+			return false;
+
+		position = result.ptr - text.data();
+
+		return true;
+	}
+
+	std::string_view text;
+	size_t position;
+};
+
+
+//
+// Function: evaluateExpression()
+//
+// Parameters:
+//    pText - Number or arithmetic expression
+//    pValue - Result, written on success
+//
+// Returns:
+//    true if the text is well formed and the value is finite
+//
+
+bool evaluateExpression(std::string_view pText, double* pValue) {
+
+	double value = 0.0;
+	ExpressionParser parser(pText);
+
+	if (!parser.evaluate(&value) || !std::isfinite(value))
+		return false;
+
+	*pValue = value;
+
+	return true;
+}
+
+
+//
+// Function: ParameterTable()
+//
+// Parameters:
+//    pFilename - Sweep file
+//    pSidecar - Use and refresh the binary sidecar
+//
+
+ParameterTable::ParameterTable(std::string pFilename, bool pSidecar) :
+	count(0), presentMask(0), filename(pFilename) {
+
+	uint64_t size = 0, modified = 0;
+
+	if (!fileStamp(pFilename, &size, &modified)) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	std::string sidecarFile = pFilename + ".bin";
+
+	if (pSidecar && mapSidecar(sidecarFile, size, modified)) {
+		LogLine(_LOG_DEBUG_, "Mapped sidecar").field("file", sidecarFile).field("rows", count);
+		return;
+	}
+
+	parse(pFilename);
+
+	LogLine(_LOG_DEBUG_, "Parsed sweep").field("file", pFilename).field("rows", count)
+		.field("errors", static_cast<uint64_t>(rowErrors.size()));
+
+	// A file with bad rows is parsed again next time so they are reported again
+	if (pSidecar && rowErrors.empty())
+		writeSidecar(sidecarFile, size, modified);
+}
+
+
+//
+// Function: mapSidecar()
+//
+// Returns:
+//    true if the sidecar belongs to this version of the file and is
+//    now mapped
+//
+
+bool ParameterTable::mapSidecar(std::string pSidecar, uint64_t pSize, uint64_t pModified) {
+
+	uint64_t sidecarSize = 0, sidecarModified = 0;
+
+	if (!fileStamp(pSidecar, &sidecarSize, &sidecarModified) || (sidecarSize < sizeof(ParameterHeader)))
+		return false;
+
+	std::unique_ptr<MappedFile> mapping(new MappedFile(pSidecar));
+
+	ParameterHeader header;
+	std::copy(mapping->data(), mapping->data() + sizeof(header), reinterpret_cast<char*>(&header));
+
+	if ((header.magic != _Parameter_Magic_) || (header.version != _Parameter_Version_) ||
+		(header.sourceSize != pSize) || (header.sourceModified != pModified) ||
+		(header.columns != _Number_Of_Parameters_) ||
+		(mapping->size() != sizeof(header) + header.rows * header.columns * sizeof(double)))
+		return false;
+
+	auto data = reinterpret_cast<const double*>(mapping->data() + sizeof(header));
+
+	for (auto c = 0u; c < _Number_Of_Parameters_; c++)
+		columns[c] = data + c * header.rows;
+
+	count = header.rows;
+	presentMask = header.present;
+	sidecar.swap(mapping);
+
+	return true;
+}
+
+
+//
+// Function: parse()
+//
+// Description:
+//    Streams the rows into the table, which is the only allocation and
+//    is sized from the number of lines
+//
+
+void ParameterTable::parse(std::string pFilename) {
+
+	ParameterReader reader(pFilename);
+
+	uint64_t capacity = reader.lines();
+	storage.assign(capacity * _Number_Of_Parameters_, std::numeric_limits<double>::quiet_NaN());
+
+	for (auto c = 0u; c < _Number_Of_Parameters_; c++)
+		columns[c] = storage.data() + c * capacity;
+
+	presentMask = reader.present();
+
+	ParameterRow row;
+
+	while (reader.next(&row)) {
+		for (auto c = 0u; c < _Number_Of_Parameters_; c++)
+			storage[c * capacity + count] = row.values[c];
+
+		count++;
+	}
+
+	rowErrors = reader.errors();
+}
+
+
+//
+// Function: ParameterReader()
+//
+// Parameters:
+//    pFilename - Sweep file, the header row is read here
+//
+
+ParameterReader::ParameterReader(std::string pFilename) :
+	source(pFilename), text(source.data(), source.size()),
+	filename(pFilename), position(0), line(0), index(0), presentMask(0) {
+
+	//
+	// The first non-empty row names the columns
+	//
+
+	while (position < text.size()) {
+		auto fieldCount = tokenizeRow(nextLine(), &fields);
+
+		if ((fieldCount == 1) && fields[0].empty())
+			continue;
+
+		slots.assign(fieldCount, -1);
+
+		for (auto f = 0u; f < fieldCount; f++) {
+			for (auto c = 0u; c < _Number_Of_Parameters_; c++) {
+				if (fields[f] != parameterNames[c])
+					continue;
+
+				if ((presentMask >> c) & 1)
+					crash(__LINE__, __FILE__, __FUNCTION__,
+						"Duplicate column " + std::string(fields[f]) + " in " + pFilename);
+
+				presentMask |= (1ULL << c);
+				slots[f] = c;
+			}
+
+			if (slots[f] < 0)
+				LogLine(_LOG_WARN_, "Ignoring column").field("file", pFilename)
+					.field("column", std::string(fields[f]));
+		}
+
+		break;
+	}
+
+	if (presentMask == 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "No parameter columns in " + pFilename);
+}
+
+
+//
+// Function: lines()
+//
+// Returns:
+//    Number of lines in the file, an upper bound on the rows
+//
+
+uint64_t ParameterReader::lines() const {
+	return std::count(text.begin(), text.end(), '\n') + 1;
+}
+
+
+//
+// Function: nextLine()
+//
+
+std::string_view ParameterReader::nextLine() {
+
+	auto end = text.find('\n', position);
+
+	if (end == std::string_view::npos)
+		end = text.size();
+
+	auto row = text.substr(position, end - position);
+	position = end + 1;
+	line++;
+
+	return row;
+}
+
+
+//
+// Function: addError()
+//
+
+void ParameterReader::addError(std::string pMessage) {
+
+	LogLine(_LOG_WARN_, "Bad parameter row").field("file", filename)
+		.field("line", line).field("error", pMessage);
+
+	rowErrors.push_back({ line, pMessage });
+}
+
+
+//
+// Function: next()
+//
+// Parameters:
+//    pRow - Next good row, written
+//
+// Returns:
+//    false at the end of the file.  Bad rows are reported and skipped.
+//
+
+bool ParameterReader::next(ParameterRow* pRow) {
+
+	while (position < text.size()) {
+		auto fieldCount = tokenizeRow(nextLine(), &fields);
+
+		if ((fieldCount == 1) && fields[0].empty())
+			continue;
+
+		if (fieldCount != slots.size()) {
+			addError("expected " + std::to_string(slots.size()) + " fields, found "
+				+ std::to_string(fieldCount));
+			continue;
+		}
+
+		bool good = true;
+
+		for (auto c = 0u; c < _Number_Of_Parameters_; c++)
+			pRow->values[c] = std::numeric_limits<double>::quiet_NaN();
+
+		for (auto f = 0u; good && (f < fieldCount); f++) {
+			if (slots[f] < 0)
+				continue;
+
+			if (!evaluateExpression(fields[f], &pRow->values[slots[f]])) {
+				addError(std::string(parameterNames[slots[f]]) + " cannot be evaluated: "
+					+ std::string(fields[f]));
+				good = false;
+			}
+		}
+
+		if (good) {
+			pRow->line = line;
+			pRow->index = index++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+// Function: writeSidecar()
+//
+// Description:
+//    Written beside the target and renamed, so a reader never maps a
+//    partial sidecar.  Failing to write it only costs the next load
+//    a parse.
+//
+
+void ParameterTable::writeSidecar(std::string pSidecar, uint64_t pSize, uint64_t pModified) {
+
+	ParameterHeader header = {};
+	header.magic = _Parameter_Magic_;
+	header.version = _Parameter_Version_;
+	header.sourceSize = pSize;
+	header.sourceModified = pModified;
+	header.rows = count;
+	header.columns = _Number_Of_Parameters_;
+	header.present = presentMask;
+
+	std::string temporary = pSidecar + ".tmp";
+
+	{
+		std::ofstream outFile(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (outFile.is_open()) {
+			outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+			for (auto c = 0u; c < _Number_Of_Parameters_; c++)
+				outFile.write(reinterpret_cast<const char*>(columns[c]), count * sizeof(double));
+		}
+
+		if (!outFile.is_open() || !outFile.good()) {
+			LogLine(_LOG_WARN_, "Unable to write sidecar").field("file", pSidecar);
+			std::remove(temporary.c_str());
+			return;
+		}
+	}
+
+	if (std::rename(temporary.c_str(), pSidecar.c_str()) != 0) {
+		LogLine(_LOG_WARN_, "Unable to replace sidecar").field("file", pSidecar);
+		std::remove(temporary.c_str());
+	}
+}
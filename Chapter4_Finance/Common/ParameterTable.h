@@ -0,0 +1,200 @@
+
+/*
+ * Typed parameter sweep table
+ *
+ * A sweep file is a CSV file whose header row names the parameters.
+ * Columns are matched to the Parameters.h slots by name, so they may
+ * come in any order and unknown columns are ignored.  Every cell may
+ * be a simple arithmetic expression such as 1.0 / 12.0, which is
+ * evaluated once at load time.  Rows are parsed straight out of the
+ * mapped file into one array per parameter, so no row is ever copied
+ * and memory beyond the table itself stays constant.  Bad rows are
+ * collected and reported, not fatal.
+ *
+ * A clean load writes a binary sidecar, <file>.bin, holding the
+ * columns.  It is stamped with the size and modification time of the
+ * CSV file, and while they match a repeat load maps the sidecar and
+ * parses nothing.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version, replaces importParameters()
+ *
+ * 2026-10-19  JJL     ParameterReader streams rows one at a time
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Local Includes
+//
+
+#include "../Common/Parameters.h"
+#include "../Common/MappedFile.h"
+
+
+//
+// Definitions
+//
+
+#define _Parameter_Magic_     0x5045455753524150ULL
+#define _Parameter_Version_   1
+
+
+//
+// Structure: ParameterError
+//
+
+struct ParameterError {
+	uint64_t line;
+	std::string message;
+};
+
+
+//
+// Structure: ParameterHeader
+//
+// Description:
+//    Start of the binary sidecar, followed by the columns in
+//    Parameters.h order, rows doubles each
+//
+
+struct ParameterHeader {
+	uint64_t magic;
+	uint64_t version;
+	uint64_t sourceSize;
+	uint64_t sourceModified;
+	uint64_t rows;
+	uint64_t columns;
+	uint64_t present;
+	uint64_t reserved;
+};
+
+
+//
+// Structure: ParameterRow
+//
+// Description:
+//    One good row, values in Parameters.h order, NaN where the file
+//    has no such column
+//
+
+struct ParameterRow {
+	uint64_t line;
+	uint64_t index;
+	double values[_Number_Of_Parameters_];
+};
+
+
+//
+// Class: ParameterReader
+//
+// Description:
+//    Streams the good rows of a sweep file in file order.  Memory does
+//    not depend on the size of the file.
+//
+
+class ParameterReader {
+public:
+	ParameterReader(std::string pFilename);
+
+	ParameterReader(const ParameterReader&) = delete;
+	ParameterReader& operator=(const ParameterReader&) = delete;
+
+	bool next(ParameterRow* pRow);
+
+	uint64_t lines() const;
+	uint64_t present() const { return presentMask; }
+	const std::vector<ParameterError>& errors() const { return rowErrors; }
+
+private:
+	std::string_view nextLine();
+	void addError(std::string pMessage);
+
+	MappedFile source;
+	std::string_view text;
+	std::string filename;
+	size_t position;
+	uint64_t line;
+	uint64_t index;
+	uint64_t presentMask;
+	std::vector<std::string_view> fields;
+	std::vector<int> slots;
+	std::vector<ParameterError> rowErrors;
+};
+
+
+//
+// Class: ParameterTable
+//
+// Description:
+//    Struct of arrays parameter table.  A column that is not in the
+//    file reads as NaN and present() is false for it.
+//
+
+class ParameterTable {
+public:
+	ParameterTable(std::string pFilename, bool pSidecar = true);
+
+	ParameterTable(const ParameterTable&) = delete;
+	ParameterTable& operator=(const ParameterTable&) = delete;
+
+	uint64_t rows() const { return count; }
+	const double* column(unsigned int pColumn) const { return columns[pColumn]; }
+	double value(uint64_t pRow, unsigned int pColumn) const { return columns[pColumn][pRow]; }
+	bool present(unsigned int pColumn) const { return (presentMask >> pColumn) & 1; }
+
+	const std::vector<ParameterError>& errors() const { return rowErrors; }
+	bool fromSidecar() const { return (sidecar != nullptr); }
+
+private:
+	bool mapSidecar(std::string pSidecar, uint64_t pSize, uint64_t pModified);
+	void parse(std::string pFilename);
+	void writeSidecar(std::string pSidecar, uint64_t pSize, uint64_t pModified);
+
+	std::unique_ptr<MappedFile> sidecar;
+	std::vector<double> storage;
+	const double* columns[_Number_Of_Parameters_];
+	uint64_t count;
+	uint64_t presentMask;
+	std::vector<ParameterError> rowErrors;
+	std::string filename;
+};
+
+
+//
+// Function: evaluateExpression()
+//
+// Parameters:
+//    pText - Number or arithmetic expression of numbers, + - * / and
+//            parentheses
+//    pValue - Result, written on success
+//
+// Returns:
+//    true if the whole text is a well formed expression with a finite
+//    value
+//
+
+bool evaluateExpression(std::string_view pText, double* pValue);
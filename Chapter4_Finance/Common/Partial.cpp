@@ -0,0 +1,322 @@
+
+/*
+ * Mergeable partial results for sharded Monte Carlo runs
+ *
+ * See also
+ * Chan, T.F., Golub, G.H., LeVeque, R.J. (1979). "Updating formulae
+ * and a pairwise algorithm for computing sample variances."
+ * Technical Report STAN-CS-79-773, Stanford University.
+ *
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Quantile sketch per block
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/Partial.h"
+#include "../Common/PathRandom.h"
+#include "../Common/Welford.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <math.h>
+
+
+//
+// Function: emptyBlock()
+//
+// Parameters:
+//    pBlock - Block index
+//
+// Returns:
+//    Accumulator with no samples
+//
+
+BlockAccumulator emptyBlock(uint64_t pBlock) {
+
+	BlockAccumulator result;
+
+	result.block = pBlock;
+	result.count = 0.0;
+	result.mean = 0.0;
+	result.M2 = 0.0;
+	result.sumError = 0.0;
+	result.minimum = std::numeric_limits<double>::max();
+	result.maximum = std::numeric_limits<double>::lowest();
+
+	std::memset(result.sketch, 0, sizeof(result.sketch));
+
+	return result;
+}
+
+
+//
+// Function: sketchBin()
+//
+// Parameters:
+//    pValue - Discounted payoff
+//
+// Returns:
+//    Bin of the sketch the value is counted in
+//
+
+static unsigned int sketchBin(double pValue) {
+
+	if (!(pValue > _Sketch_Smallest_))
+		return 0;
+
+	if (pValue >= _Sketch_Largest_)
+		return _Sketch_Bins_ - 1;
+
+	double position = log(pValue / _Sketch_Smallest_) / log(_Sketch_Largest_ / _Sketch_Smallest_);
+	auto bin = 1 + static_cast<unsigned int>(position * (_Sketch_Bins_ - 2));
+
+	return (bin < _Sketch_Bins_ - 1 ? bin : _Sketch_Bins_ - 2);
+}
+
+
+//
+// Function: accumulateBlock()
+//
+// Parameters:
+//    pBlock - Accumulator to update
+//    pValue - Discounted payoff of one path
+//    pActual - Closed form value, used for the error sum
+//
+// Returns:
+//    Nothing
+//
+
+void accumulateBlock(BlockAccumulator* pBlock, double pValue, double pActual) {
+
+	welford(&pBlock->count, &pBlock->mean, &pBlock->M2, pValue);
+
+	pBlock->sumError += pValue - pActual;
+	pBlock->minimum = (pValue < pBlock->minimum ? pValue : pBlock->minimum);
+	pBlock->maximum = (pValue > pBlock->maximum ? pValue : pBlock->maximum);
+	pBlock->sketch[sketchBin(pValue)]++;
+}
+
+
+//
+// Function: mergeBlock()
+//
+// Parameters:
+//    pTotal - Running total, updated in place
+//    pBlock - Block to fold into the total
+//
+// Returns:
+//    Nothing
+//
+
+void mergeBlock(BlockAccumulator* pTotal, const BlockAccumulator& pBlock) {
+
+	welfordMerge(&pTotal->count, &pTotal->mean, &pTotal->M2,
+		pBlock.count, pBlock.mean, pBlock.M2);
+
+	pTotal->sumError += pBlock.sumError;
+	pTotal->minimum = (pBlock.minimum < pTotal->minimum ? pBlock.minimum : pTotal->minimum);
+	pTotal->maximum = (pBlock.maximum > pTotal->maximum ? pBlock.maximum : pTotal->maximum);
+
+	for (unsigned int i = 0; i < _Sketch_Bins_; i++)
+		pTotal->sketch[i] += pBlock.sketch[i];
+}
+
+
+//
+// Function: sketchQuantile()
+//
+// Parameters:
+//    pBlock - Accumulator, a single block or a merged total
+//    pQuantile - Quantile, 0 to 1
+//
+// Returns:
+//    Geometric middle of the bin holding the quantile, kept within the
+//    minimum and maximum, 0 for no samples.  Within a bin's width of
+//    the exact quantile, values below _Sketch_Smallest_ read as the
+//    minimum.
+//
+
+double sketchQuantile(const BlockAccumulator& pBlock, double pQuantile) {
+
+	if (pBlock.count <= 0.0)
+		return 0.0;
+
+	double rank = pQuantile * pBlock.count;
+	double seen = 0.0;
+	unsigned int bin = 0;
+
+	for (; bin < _Sketch_Bins_ - 1; bin++) {
+		seen += pBlock.sketch[bin];
+
+		if (seen >= rank)
+			break;
+	}
+
+	if (bin == 0)
+		return pBlock.minimum;
+
+	if (bin == _Sketch_Bins_ - 1)
+		return pBlock.maximum;
+
+	double width = log(_Sketch_Largest_ / _Sketch_Smallest_) / (_Sketch_Bins_ - 2);
+	double value = _Sketch_Smallest_ * exp((bin - 0.5) * width);
+
+	return fmin(fmax(value, pBlock.minimum), pBlock.maximum);
+}
+
+
+//
+// Function: shardBlocks()
+//
+// Parameters:
+//    pShard - Zero based shard index
+//    pShards - Number of shards
+//    pBlocks - Number of blocks in the whole pricing
+//
+// Returns:
+//    Half open range [first, last) of blocks owned by the shard
+//
+
+std::tuple<uint64_t, uint64_t> shardBlocks(uint64_t pShard, uint64_t pShards, uint64_t pBlocks) {
+
+	std::tuple<uint64_t, uint64_t> result;
+
+	std::get<_Shard_First_>(result) = (pShard * pBlocks) / pShards;
+	std::get<_Shard_Last_>(result) = ((pShard + 1) * pBlocks) / pShards;
+
+	return result;
+}
+
+
+//
+// Function: hashParameters()
+//
+// Parameters:
+//    pValues - Model parameters
+//    pCount - Number of parameters
+//    pKernel - Name of the model, scheme and payoff
+//
+// Returns:
+//    Fingerprint used to refuse merging partials of different pricings
+//
+
+uint64_t hashParameters(const double* pValues, unsigned int pCount, std::string pKernel) {
+
+	uint64_t hash = 0;
+
+	for (auto i = 0u; i < pCount; i++) {
+		uint64_t bits = 0;
+		std::memcpy(&bits, &pValues[i], sizeof(bits));
+
+		hash ^= bits;
+		hash = splitMix64(hash);
+	}
+
+	for (auto c : pKernel) {
+		hash ^= static_cast<unsigned char>(c);
+		hash = splitMix64(hash);
+	}
+
+	return hash;
+}
+
+
+//
+// Function: writePartial()
+//
+// Parameters:
+//    pFilename - Output file
+//    pHeader - Pricing description, records is filled in here
+//    pBlocks - Accumulators of the blocks simulated by this shard
+//
+// Returns:
+//    Nothing
+//
+
+void writePartial(std::string pFilename, PartialHeader pHeader,
+	const std::vector<BlockAccumulator>& pBlocks) {
+
+	std::ofstream outFile(pFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!outFile.is_open()) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	pHeader.magic = _Partial_Magic_;
+	pHeader.version = _Partial_Version_;
+	pHeader.records = pBlocks.size();
+
+	outFile.write(reinterpret_cast<const char*>(&pHeader), sizeof(pHeader));
+	outFile.write(reinterpret_cast<const char*>(pBlocks.data()),
+		pBlocks.size() * sizeof(BlockAccumulator));
+
+	if (!outFile.good()) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to write " + pFilename);
+	}
+}
+
+
+//
+// Function: readPartial()
+//
+// Parameters:
+//    pFilename - Partial file written by writePartial()
+//
+// Returns:
+//    Header and block accumulators
+//
+
+std::tuple<PartialHeader, std::vector<BlockAccumulator>> readPartial(std::string pFilename) {
+
+	std::ifstream inFile(pFilename, std::ios::in | std::ios::binary);
+
+	if (!inFile.is_open()) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	PartialHeader header;
+	inFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	if (!inFile.good() || header.magic != _Partial_Magic_) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Not a partial result file: " + pFilename);
+	}
+
+	if (header.version != _Partial_Version_) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unsupported partial result version: " + pFilename);
+	}
+
+	std::vector<BlockAccumulator> blocks(header.records);
+	inFile.read(reinterpret_cast<char*>(blocks.data()),
+		blocks.size() * sizeof(BlockAccumulator));
+
+	if (static_cast<uint64_t>(inFile.gcount()) != blocks.size() * sizeof(BlockAccumulator)) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Truncated partial result file: " + pFilename);
+	}
+
+	return std::make_tuple(header, blocks);
+}
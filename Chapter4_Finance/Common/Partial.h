@@ -0,0 +1,134 @@
+
+/*
+ * Mergeable partial results for sharded Monte Carlo runs
+ *
+ * A pricing is cut into fixed size blocks of paths.  Each block keeps
+ * its own accumulators and a shard writes the blocks it simulated to a
+ * binary partial file.  Merging the blocks in block order gives exactly
+ * the same answer as a single run, which merges the same blocks in the
+ * same order.
+ *
+ * Each block also keeps a quantile sketch, a count per bin of fixed
+ * log spaced bins.  Counts add exactly in any order, so the sketch of
+ * the merged blocks is the sketch of the whole run.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Quantile sketch per block
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// STL Includes
+//
+
+#include <tuple>
+#include <vector>
+
+
+//
+// Definitions
+//
+
+#define _Partial_Magic_        0x5452415043524148ULL
+#define _Partial_Version_      2
+#define _Partial_Block_Size_   1024
+
+// Bin 0 holds values up to the smallest, the last values from the
+// largest, the others split the range evenly in log, each about 16%
+// wide, so a quantile is read within about 8%
+#define _Sketch_Bins_       128
+#define _Sketch_Smallest_   1e-4
+#define _Sketch_Largest_    1e4
+
+#define _Shard_First_   0
+#define _Shard_Last_    1
+
+
+//
+// Structure: PartialHeader
+//
+// Description:
+//    Identifies the pricing a partial file belongs to.  Every field
+//    except shard and records must agree before partials are merged.
+//
+
+struct PartialHeader {
+	uint64_t magic;
+	uint64_t version;
+	uint64_t shard;
+	uint64_t shards;
+	uint64_t seed;
+	uint64_t sims;
+	uint64_t steps;
+	uint64_t blockSize;
+	uint64_t blocks;
+	uint64_t parameterHash;
+	uint64_t records;
+	double actual;
+};
+
+
+//
+// Structure: BlockAccumulator
+//
+// Description:
+//    Statistics of the discounted payoff over one block of paths.
+//    sketch counts the payoffs in each bin, see sketchQuantile().
+//
+
+struct BlockAccumulator {
+	uint64_t block;
+	double count;
+	double mean;
+	double M2;
+	double sumError;
+	double minimum;
+	double maximum;
+	uint32_t sketch[_Sketch_Bins_];
+};
+
+
+//
+// Function prototypes
+//
+
+BlockAccumulator emptyBlock(uint64_t pBlock);
+
+void accumulateBlock(BlockAccumulator* pBlock, double pValue, double pActual);
+
+void mergeBlock(BlockAccumulator* pTotal, const BlockAccumulator& pBlock);
+
+double sketchQuantile(const BlockAccumulator& pBlock, double pQuantile);
+
+std::tuple<uint64_t, uint64_t> shardBlocks(uint64_t pShard, uint64_t pShards, uint64_t pBlocks);
+
+uint64_t hashParameters(const double* pValues, unsigned int pCount, std::string pKernel);
+
+void writePartial(std::string pFilename, PartialHeader pHeader,
+	const std::vector<BlockAccumulator>& pBlocks);
+
+std::tuple<PartialHeader, std::vector<BlockAccumulator>> readPartial(std::string pFilename);
@@ -0,0 +1,1259 @@
+
+/*
+ * Compile time specialized path simulation kernel
+ *
+ * A path is simulated by simulatePath<Model, Scheme, Payoff, Steps>().
+ * The model decides which factors are stochastic, the scheme decides
+ * how a single factor is advanced over one time step and the payoff
+ * turns the terminal state into a sample.  Every combination is a
+ * separate instantiation, so the step loop contains no virtual calls
+ * and no branches on the choice of model or scheme.  When Steps is
+ * non-zero the trip count is a compile time constant and the compiler
+ * is free to unroll the step loop.
+ *
+ * Implementation of
+ * Alexey Medvedev, Olivier Scaillet "Pricing American options under
+ * stochastic volatility and stochastic interest rates"
+ * Journal of Financial Economics. 2010.
+ *
+ * See also
+ * Kloeden, P.E., Platen, E. (1992). "Numerical Solution of Stochastic
+ * Differential Equations." Springer.
+ *
+ * Andersen, L. (2008). "Simple and efficient simulation of the Heston
+ * stochastic volatility model." Journal of Computational Finance,
+ * 11(3), pp. 1-42.
+ *
+ * Broadie, M., Kaya, O. (2006). "Exact simulation of stochastic
+ * volatility and other affine jump diffusion processes." Operations
+ * Research, 54(2), pp. 217-231.
+ *
+ * Giles, M.B., Lester, C., Whittle, J. (2016). "Non-nested adaptive
+ * timesteps in multilevel Monte Carlo computations." Monte Carlo and
+ * Quasi-Monte Carlo Methods 2014, Springer, pp. 303-314.
+ *
+ * Giles, M.B., Szpruch, L. (2014). "Antithetic multilevel Monte Carlo
+ * estimation for multi-dimensional SDEs without Levy area
+ * simulation." The Annals of Applied Probability, 24(4),
+ * pp. 1585-1620.
+ *
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     simulateLevel() samples the fine minus coarse
+ *                     difference of a multilevel Monte Carlo level
+ *
+ * 2026-10-19  JJL     Antithetic level estimator, Milstein keeps
+ *                     the symmetric part of the S, v cross term
+ *
+ * 2026-10-19  JJL     simulateIndex() samples the mixed differences
+ *                     of multi-index Monte Carlo for HHW
+ *
+ * 2026-10-19  JJL     simulateQuasiLevel() drives a level with
+ *                     randomized Sobol points through a Brownian
+ *                     bridge
+ *
+ * 2026-10-19  JJL     simulateAdaptiveLevel() steps v and r with path
+ *                     dependent time steps that refine near zero
+ *
+ * 2026-10-19  JJL     Andersen's quadratic exponential scheme for v
+ *                     and r with the martingale corrected S step
+ *
+ * 2026-10-19  JJL     Exact transition of v and r from tabulated
+ *                     noncentral chi-square quantiles
+ *
+ * 2026-10-19  JJL     simulateRichardsonBlocks() extrapolates coupled
+ *                     paths at k step refinements to zero step size
+ *
+ * 2026-10-19  JJL     simulateIndex() and simulateSplitPath() removed
+ *                     with -mimc
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <limits>
+#include <math.h>
+#include <random>
+
+
+//
+// STL Includes
+//
+
+#include <array>
+#include <vector>
+
+
+//
+// Local Includes
+//
+
+#include "Simulation.h"
+#include "PathRandom.h"
+#include "Partial.h"
+#include "MLMC.h"
+#include "QuasiRandom.h"
+#include "NoncentralChiSquare.h"
+#include "cholesky.h"
+
+
+//
+// Definitions
+//
+
+// Most step refinements one Richardson-Romberg path combines
+#define _Richardson_Max_Refinements_   8
+
+// Smallest adaptive step as a fraction of the uniform one
+#define _Adaptive_Max_Refinement_   64.0
+
+
+//
+// Structure: PathState
+//
+// Description:
+//    State of one path.  intr accumulates the integral of r and is
+//    used to discount the payoff.
+//
+
+struct PathState {
+	double S;
+	double v;
+	double r;
+	double intr;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//
+// Schemes
+//
+// asset() advances dS = mu S dt + sigma S dW and squareRoot() advances
+// dx = kappa (theta - x) dt + xi sqrt(x) dW over one step of size dt.
+// cross() is the scheme's term c I_ij for a diffusion coefficient that
+// depends on the state driven by another, correlated factor.
+//
+
+struct EulerMaruyama {
+	static inline double asset(double pS, double pMu, double pSigma, double pdW, double pdt) {
+		return pS + pMu * pS * pdt + pSigma * pS * pdW;
+	}
+
+	static inline double squareRoot(double pX, double pKappa, double pTheta, double pXi, double pdW, double pdt) {
+		return pX + pKappa * (pTheta - pX) * pdt + pXi * sqrt(pX) * pdW;
+	}
+
+	static inline double cross(double, double, double, double, double) {
+		return 0.0;
+	}
+};
+
+
+//
+// Milstein adds the diagonal correction 1/2 b b' (dW^2 - dt).  For the
+// asset b = sigma S, and for the square root processes b b' = xi^2 / 2.
+// Of the cross terms c I_ij only the symmetric part
+// c (dWi dWj - rho dt) / 2 is kept, the Levy area would have to be
+// simulated.  This is the truncated scheme of Giles and Szpruch, whose
+// error the antithetic level estimator cancels.
+//
+
+struct Milstein {
+	static inline double asset(double pS, double pMu, double pSigma, double pdW, double pdt) {
+		return pS + pMu * pS * pdt + pSigma * pS * pdW
+			+ 0.5 * pSigma * pSigma * pS * (pdW * pdW - pdt);
+	}
+
+	static inline double squareRoot(double pX, double pKappa, double pTheta, double pXi, double pdW, double pdt) {
+		return pX + pKappa * (pTheta - pX) * pdt + pXi * sqrt(pX) * pdW
+			+ 0.25 * pXi * pXi * (pdW * pdW - pdt);
+	}
+
+	static inline double cross(double pC, double pdWi, double pdWj, double pRho, double pdt) {
+		return 0.5 * pC * (pdWi * pdWj - pRho * pdt);
+	}
+};
+
+
+//
+// Log-Euler steps ln S with the Ito correction, which is exact for
+// GBM and keeps S positive.  The square root processes use Euler.
+//
+
+struct LogEuler {
+	static inline double asset(double pS, double pMu, double pSigma, double pdW, double pdt) {
+		return pS * exp((pMu - 0.5 * pSigma * pSigma) * pdt + pSigma * pdW);
+	}
+
+	static inline double squareRoot(double pX, double pKappa, double pTheta, double pXi, double pdW, double pdt) {
+		return EulerMaruyama::squareRoot(pX, pKappa, pTheta, pXi, pdW, pdt);
+	}
+
+	static inline double cross(double, double, double, double, double) {
+		return 0.0;
+	}
+};
+
+
+//
+// Andersen's quadratic exponential scheme samples the square root
+// processes from a distribution with their exact conditional mean m and
+// variance s^2 over the step.  With psi = s^2 / m^2 at most 1.5 the new
+// value is a (b + Z)^2, otherwise it is 0 with probability p and
+// exponential with rate beta above, taking Z through the normal
+// distribution function.  Z is the step's Brownian increment over
+// sqrt(dt), so the coarse and fine paths of a level stay coupled.  It
+// stays non-negative and accurate over steps far longer than Euler can
+// take when the Feller condition fails.  The asset steps with log-Euler
+// unless the model steps S and v together, see assetVariance().
+//
+
+struct QuadraticExponential {
+	struct Moments {
+		bool quadratic;
+		double a, b;      // Quadratic branch
+		double p, beta;   // Exponential branch
+		double mean;
+	};
+
+	static inline Moments moments(double pX, double pKappa, double pTheta, double pXi, double pdt) {
+		Moments result = { true, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+		double e = exp(-pKappa * pdt);
+		double decay = (pKappa > 0.0 ? (1.0 - e) / pKappa : pdt);
+
+		double m = pTheta + (fmax(pX, 0.0) - pTheta) * e;
+		double s2 = pXi * pXi * decay * (fmax(pX, 0.0) * e + 0.5 * pTheta * pKappa * decay);
+
+		result.mean = m;
+
+		// Deterministic step, or nothing left to sample
+		if ((s2 <= 0.0) || (m <= 0.0)) {
+			result.a = fmax(m, 0.0);
+			result.b = 1.0;
+			result.quadratic = false;
+			result.p = (m > 0.0 ? 0.0 : 1.0);
+			result.beta = (m > 0.0 ? std::numeric_limits<double>::max() : 0.0);
+			return result;
+		}
+
+		double psi = s2 / (m * m);
+
+		if (psi <= 1.5) {
+			double b2 = 2.0 / psi - 1.0 + sqrt(2.0 / psi) * sqrt(2.0 / psi - 1.0);
+			result.b = sqrt(b2);
+			result.a = m / (1.0 + b2);
+		}
+		else {
+			result.quadratic = false;
+			result.p = (psi - 1.0) / (psi + 1.0);
+			result.beta = (1.0 - result.p) / m;
+		}
+
+		return result;
+	}
+
+	static inline double sample(const Moments& pM, double pZ) {
+		if (pM.quadratic)
+			return pM.a * (pM.b + pZ) * (pM.b + pZ);
+
+		if (pM.beta == std::numeric_limits<double>::max())
+			return pM.mean;
+
+		double U = 0.5 * erfc(-pZ * M_SQRT1_2);
+
+		return (U <= pM.p ? 0.0 : log((1.0 - pM.p) / (1.0 - U)) / pM.beta);
+	}
+
+	static inline double asset(double pS, double pMu, double pSigma, double pdW, double pdt) {
+		return LogEuler::asset(pS, pMu, pSigma, pdW, pdt);
+	}
+
+	static inline double squareRoot(double pX, double pKappa, double pTheta, double pXi, double pdW, double pdt) {
+		return sample(moments(pX, pKappa, pTheta, pXi, pdt), pdW / sqrt(pdt));
+	}
+
+	static inline double cross(double, double, double, double, double) {
+		return 0.0;
+	}
+};
+
+
+//
+// The exact scheme draws the square root processes from their
+// transition distribution, c times a noncentral chi-square with
+// d = 4 kappa theta / xi^2 degrees of freedom and noncentrality
+// x exp(-kappa dt) / c, where c = xi^2 (1 - exp(-kappa dt)) / (4 kappa).
+// The quantile at Phi(Z) comes from the table of d, so a step costs an
+// exponential, a square root and a bilinear interpolation, and Z is
+// again the Brownian increment over sqrt(dt) to keep levels coupled.
+// Without mean reversion, level or noise d is not defined and the step
+// falls back to the quadratic exponential one.  In the stochastic
+// volatility models S takes Andersen's step given the exact v', see
+// assetVariance(), so the scheme's only time step error is the
+// trapezoid rule for the integral of v.
+//
+
+struct ExactCIR {
+	static inline double asset(double pS, double pMu, double pSigma, double pdW, double pdt) {
+		return LogEuler::asset(pS, pMu, pSigma, pdW, pdt);
+	}
+
+	static inline double squareRoot(double pX, double pKappa, double pTheta, double pXi, double pdW, double pdt) {
+		if ((pKappa <= 0.0) || (pTheta <= 0.0) || (pXi <= 0.0))
+			return QuadraticExponential::squareRoot(pX, pKappa, pTheta, pXi, pdW, pdt);
+
+		auto& table = NoncentralChiSquareTable::forDegrees(4.0 * pKappa * pTheta / (pXi * pXi));
+
+		double e = exp(-pKappa * pdt);
+		double c = pXi * pXi * (1.0 - e) / (4.0 * pKappa);
+
+		return c * table.quantile(fmax(pX, 0.0) * e / c, pdW / sqrt(pdt));
+	}
+
+	static inline double cross(double, double, double, double, double) {
+		return 0.0;
+	}
+};
+
+
+//
+// Function: assetVariance()
+//
+// Parameters:
+//    pX - State at the start of the step
+//    pP - Simulation parameters
+//    pdW - Correlated increments, S in pdW[0] and v in pdW[1]
+//    pdt - Step
+//    pS, pv - Asset and variance at the end of the step
+//
+// Comments:
+//    Steps S and v of the stochastic volatility models.  Every scheme
+//    but the quadratic exponential and exact ones advances them one at
+//    a time.
+//
+
+template<class Scheme>
+inline void assetVariance(const PathState& pX, const SimulationParameters& pP,
+	const double* pdW, double pdt, double* pS, double* pv) {
+
+	*pS = Scheme::asset(pX.S, pX.r, sqrt(pX.v), pdW[0], pdt)
+		+ Scheme::cross(0.5 * pP.sigmav * pX.S, pdW[1], pdW[0], pP.rho[0][1], pdt);
+	*pv = Scheme::squareRoot(pX.v, pP.Kv, pP.vbar, pP.sigmav, pdW[1], pdt);
+}
+
+
+//
+// Andersen's S step integrates v over the step with the trapezoid rule
+// and takes the part of the S noise driven by v from the change in v,
+//
+//    ln S' = ln S + r dt + K0 + K1 v + K2 v' + sqrt(K3 v + K4 v') Z
+//
+// where Z is the part of the S increment independent of the v one.
+// K0 is chosen so that E[S'] = S exp(r dt) exactly, the martingale
+// correction, whenever the moment generating function of v' exists at
+// K2 + K4 / 2, which holds for any step of practical size.
+//
+
+template<>
+inline void assetVariance<QuadraticExponential>(const PathState& pX, const SimulationParameters& pP,
+	const double* pdW, double pdt, double* pS, double* pv) {
+
+	typedef QuadraticExponential QE;
+
+	const double rho = pP.rho[0][1];
+	const double sqrtdt = sqrt(pdt);
+	const double Zv = pdW[1] / sqrtdt;
+
+	auto moments = QE::moments(pX.v, pP.Kv, pP.vbar, pP.sigmav, pdt);
+	double v = QE::sample(moments, Zv);
+
+	if (pP.sigmav <= 0.0) {
+		*pS = LogEuler::asset(pX.S, pX.r, sqrt(fmax(pX.v, 0.0)), pdW[0], pdt);
+		*pv = v;
+		return;
+	}
+
+	double K1 = 0.5 * pdt * (pP.Kv * rho / pP.sigmav - 0.5) - rho / pP.sigmav;
+	double K2 = 0.5 * pdt * (pP.Kv * rho / pP.sigmav - 0.5) + rho / pP.sigmav;
+	double K3 = 0.5 * pdt * (1.0 - rho * rho);
+	double K4 = K3;
+
+	// Martingale correction, E[exp(A v')] in closed form on each branch
+	double A = K2 + 0.5 * K4;
+	double K0 = -rho * pP.Kv * pP.vbar * pdt / pP.sigmav;
+
+	if (moments.quadratic && (2.0 * A * moments.a < 1.0)) {
+		double d = 1.0 - 2.0 * A * moments.a;
+		K0 = -(A * moments.b * moments.b * moments.a / d - 0.5 * log(d)) - (K1 + 0.5 * K3) * pX.v;
+	}
+	else if (!moments.quadratic && (A < moments.beta))
+		K0 = -log(moments.p + moments.beta * (1.0 - moments.p) / (moments.beta - A)) - (K1 + 0.5 * K3) * pX.v;
+
+	double Z = (rho * rho < 1.0 ? (pdW[0] / sqrtdt - rho * Zv) / sqrt(1.0 - rho * rho) : 0.0);
+
+	*pS = pX.S * exp(pX.r * pdt + K0 + K1 * pX.v + K2 * v + sqrt(fmax(K3 * pX.v + K4 * v, 0.0)) * Z);
+	*pv = v;
+}
+
+
+//
+// Given the exact v' the S step is Andersen's without the martingale
+// correction, K0 = -rho kappa theta dt / xi, the drift interpolation of
+// Broadie and Kaya's scheme.
+//
+
+template<>
+inline void assetVariance<ExactCIR>(const PathState& pX, const SimulationParameters& pP,
+	const double* pdW, double pdt, double* pS, double* pv) {
+
+	const double rho = pP.rho[0][1];
+	const double sqrtdt = sqrt(pdt);
+	const double Zv = pdW[1] / sqrtdt;
+
+	double v = ExactCIR::squareRoot(pX.v, pP.Kv, pP.vbar, pP.sigmav, pdW[1], pdt);
+
+	if (pP.sigmav <= 0.0) {
+		*pS = LogEuler::asset(pX.S, pX.r, sqrt(fmax(pX.v, 0.0)), pdW[0], pdt);
+		*pv = v;
+		return;
+	}
+
+	double K0 = -rho * pP.Kv * pP.vbar * pdt / pP.sigmav;
+	double K1 = 0.5 * pdt * (pP.Kv * rho / pP.sigmav - 0.5) - rho / pP.sigmav;
+	double K2 = 0.5 * pdt * (pP.Kv * rho / pP.sigmav - 0.5) + rho / pP.sigmav;
+	double K3 = 0.5 * pdt * (1.0 - rho * rho);
+
+	double Z = (rho * rho < 1.0 ? (pdW[0] / sqrtdt - rho * Zv) / sqrt(1.0 - rho * rho) : 0.0);
+
+	*pS = pX.S * exp(pX.r * pdt + K0 + K1 * pX.v + K2 * v + sqrt(fmax(K3 * (pX.v + v), 0.0)) * Z);
+	*pv = v;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//
+// Function: squareRootStepLimit()
+//
+// Parameters:
+//    pX - State of dx = kappa (theta - x) dt + xi sqrt(x) dW
+//    pKappa, pXi - Mean reversion and volatility
+//
+// Returns:
+//    Largest step whose diffusion standard deviation is at most the
+//    distance to zero, xi sqrt(x h) <= x, and whose mean reversion is
+//    resolved, kappa h <= 1
+//
+
+static inline double squareRootStepLimit(double pX, double pKappa, double pXi) {
+
+	double limit = (pKappa > 0.0 ? 1.0 / pKappa : std::numeric_limits<double>::max());
+
+	if (pXi > 0.0)
+		limit = fmin(limit, pX / (pXi * pXi));
+
+	return limit;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//
+// Models
+//
+// Factors is the number of Brownian motions the model consumes per
+// step.  Every update reads the state at the start of the step.  The
+// asset diffusion sqrt(v) S depends on v, which gives the cross term
+// (sigmav S / 2) I_vS.  stepLimit() is the largest time step the state
+// allows its square root factors, see squareRootStepLimit().
+//
+
+struct GBM {
+	static constexpr unsigned int Factors = 1;
+
+	template<class Scheme>
+	static inline void step(PathState& pX, const SimulationParameters&, const double* pdW, double pdt) {
+		pX.intr += pX.r * pdt;
+		pX.S = fmax(Scheme::asset(pX.S, pX.r, sqrt(pX.v), pdW[0], pdt), 0.0);
+	}
+
+	static inline double stepLimit(const PathState&, const SimulationParameters&) {
+		return std::numeric_limits<double>::max();
+	}
+};
+
+
+struct Heston {
+	static constexpr unsigned int Factors = 2;
+
+	template<class Scheme>
+	static inline void step(PathState& pX, const SimulationParameters& pP, const double* pdW, double pdt) {
+		double S, v;
+		assetVariance<Scheme>(pX, pP, pdW, pdt, &S, &v);
+
+		pX.intr += pX.r * pdt;
+		pX.S = fmax(S, 0.0);
+		pX.v = fmax(v, 0.0);
+	}
+
+	static inline double stepLimit(const PathState& pX, const SimulationParameters& pP) {
+		return squareRootStepLimit(pX.v, pP.Kv, pP.sigmav);
+	}
+};
+
+
+struct HHW {
+	static constexpr unsigned int Factors = 3;
+
+	template<class Scheme>
+	static inline void step(PathState& pX, const SimulationParameters& pP, const double* pdW, double pdt) {
+		double S, v;
+		assetVariance<Scheme>(pX, pP, pdW, pdt, &S, &v);
+		double r = Scheme::squareRoot(pX.r, pP.Kr, pP.rbar, pP.sigmar, pdW[2], pdt);
+
+		pX.intr += pX.r * pdt;
+		pX.S = fmax(S, 0.0);
+		pX.v = fmax(v, 0.0);
+		pX.r = fmax(r, 0.0);
+	}
+
+	static inline double stepLimit(const PathState& pX, const SimulationParameters& pP) {
+		return fmin(squareRootStepLimit(pX.v, pP.Kv, pP.sigmav),
+			squareRootStepLimit(pX.r, pP.Kr, pP.sigmar));
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//
+// Payoffs
+//
+
+struct EuropeanPut {
+	static inline double value(const PathState& pX, const SimulationParameters& pP) {
+		return exp(-pX.intr) * fmax(pP.K - pX.S, 0.0);
+	}
+};
+
+
+struct EuropeanCall {
+	static inline double value(const PathState& pX, const SimulationParameters& pP) {
+		return exp(-pX.intr) * fmax(pX.S - pP.K, 0.0);
+	}
+};
+
+
+// Undiscounted terminal asset price, E[S(T)] = S0 exp(r T) under GBM
+struct AssetPrice {
+	static inline double value(const PathState& pX, const SimulationParameters&) {
+		return pX.S;
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//
+// Function: simulatePath()
+//
+// Parameters:
+//    pP - Simulation parameters
+//    pL - Cholesky factor of pP.rho
+//    pSeed, pPath - Address of the path's random stream
+//
+// Returns:
+//    Payoff of the path
+//
+// Comments:
+//    Steps = 0 takes the number of steps from pP.steps at run time.
+//
+
+template<class Model, class Scheme, class Payoff, unsigned int Steps>
+inline double simulatePath(const SimulationParameters& pP,
+	const std::array<std::array<double, 3>, 3>& pL, uint64_t pSeed, uint64_t pPath) {
+
+	PathGenerator generator(pSeed, pPath);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	const unsigned int steps = (Steps > 0 ? Steps : pP.steps);
+	const double dt = pP.T / static_cast<double>(steps);
+	const double sqrtdt = sqrt(dt);
+
+	PathState x = { pP.S0, pP.v0, pP.r0, 0.0 };
+
+	double Z[Model::Factors], dW[Model::Factors];
+
+	for (unsigned int step = 0; step < steps; step++) {
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			Z[i] = normal(generator);
+
+		for (unsigned int i = 0; i < Model::Factors; i++) {
+			dW[i] = 0.0;
+
+			for (unsigned int k = 0; k <= i; k++)
+				dW[i] += pL[i][k] * Z[k];
+
+			dW[i] *= sqrtdt;
+		}
+
+		Model::template step<Scheme>(x, pP, dW, dt);
+	}
+
+	return Payoff::value(x, pP);
+}
+
+
+//
+// Function: simulateBlocks()
+//
+// Parameters:
+//    pP - Simulation parameters
+//    pFirstBlock, pLastBlock - Half open range of blocks to simulate
+//    pSeed - Seed shared by every shard of the pricing
+//
+// Returns:
+//    One accumulator per block, see Partial.h
+//
+
+template<class Model, class Scheme, class Payoff, unsigned int Steps>
+std::vector<BlockAccumulator> simulateBlocks(const SimulationParameters& pP,
+	uint64_t pFirstBlock, uint64_t pLastBlock, uint64_t pSeed) {
+
+	auto L = cholesky(pP.rho);
+
+	std::vector<BlockAccumulator> result;
+	result.reserve(pLastBlock - pFirstBlock);
+
+	for (auto block = pFirstBlock; block < pLastBlock; block++) {
+		auto accumulator = emptyBlock(block);
+
+		uint64_t firstPath = block * _Partial_Block_Size_;
+		uint64_t lastPath = firstPath + _Partial_Block_Size_;
+		lastPath = (lastPath > pP.sims ? pP.sims : lastPath);
+
+		for (auto path = firstPath; path < lastPath; path++) {
+			auto payoff = simulatePath<Model, Scheme, Payoff, Steps>(pP, L, pSeed, path);
+			accumulateBlock(&accumulator, payoff, pP.actual);
+		}
+
+		result.push_back(accumulator);
+	}
+
+	return result;
+}
+
+
+//
+// Function: richardsonWeights()
+//
+// Parameters:
+//    pRefinements - k, the paths take N, 2 N, ..., 2^(k-1) N steps
+//    pWeights - The k weights
+//
+// Comments:
+//    Extrapolation to zero step from h_j = 2^-j h,
+//    w_j = prod_(i != j) h_i / (h_i - h_j).  The weights sum to 1 and
+//    cancel the h, ..., h^(k-1) terms of the weak error, so k = 2 gives
+//    2 P_2N - P_N.
+//
+
+inline void richardsonWeights(unsigned int pRefinements, double* pWeights) {
+
+	for (unsigned int j = 0; j < pRefinements; j++) {
+		pWeights[j] = 1.0;
+
+		for (unsigned int i = 0; i < pRefinements; i++)
+			if (i != j)
+				pWeights[j] /= 1.0 - ldexp(1.0, static_cast<int>(i) - static_cast<int>(j));
+	}
+}
+
+
+//
+// Function: simulateRichardsonPath()
+//
+// Parameters:
+//    pP - Simulation parameters, pP.steps is N
+//    pL - Cholesky factor of pP.rho
+//    pSeed, pPath - Address of the path's random stream
+//    pRefinements - k, at most _Richardson_Max_Refinements_
+//    pWeights - From richardsonWeights()
+//
+// Returns:
+//    sum_j w_j P_j over the payoffs of the k paths
+//
+// Comments:
+//    The increments are drawn for the finest path, and every coarser
+//    path steps with their sums, so all k follow the same Brownian
+//    motion and the variance of the sum is far below that of its
+//    terms.
+//
+
+template<class Model, class Scheme, class Payoff>
+inline double simulateRichardsonPath(const SimulationParameters& pP,
+	const std::array<std::array<double, 3>, 3>& pL, uint64_t pSeed, uint64_t pPath,
+	unsigned int pRefinements, const double* pWeights) {
+
+	PathGenerator generator(pSeed, pPath);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	const unsigned int finest = pRefinements - 1;
+	const unsigned int steps = (pP.steps > 0 ? pP.steps : 1) << finest;
+	const double dt = pP.T / static_cast<double>(steps);
+	const double sqrtdt = sqrt(dt);
+
+	PathState x[_Richardson_Max_Refinements_];
+	double Z[Model::Factors], dW[_Richardson_Max_Refinements_][Model::Factors];
+
+	for (unsigned int j = 0; j < pRefinements; j++) {
+		x[j] = { pP.S0, pP.v0, pP.r0, 0.0 };
+
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			dW[j][i] = 0.0;
+	}
+
+	for (unsigned int step = 1; step <= steps; step++) {
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			Z[i] = normal(generator);
+
+		for (unsigned int i = 0; i < Model::Factors; i++) {
+			double increment = 0.0;
+
+			for (unsigned int k = 0; k <= i; k++)
+				increment += pL[i][k] * Z[k];
+
+			for (unsigned int j = 0; j < pRefinements; j++)
+				dW[j][i] += increment * sqrtdt;
+		}
+
+		// Path j steps every 2^(k-1-j) fine steps
+		for (unsigned int j = 0; j < pRefinements; j++) {
+			unsigned int stride = 1u << (finest - j);
+
+			if (step % stride != 0)
+				continue;
+
+			Model::template step<Scheme>(x[j], pP, dW[j], stride * dt);
+
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				dW[j][i] = 0.0;
+		}
+	}
+
+	double value = 0.0;
+
+	for (unsigned int j = 0; j < pRefinements; j++)
+		value += pWeights[j] * Payoff::value(x[j], pP);
+
+	return value;
+}
+
+
+//
+// Function: simulateRichardsonBlocks()
+//
+// Parameters:
+//    As simulateBlocks()
+//    pRefinements - k, 1 to _Richardson_Max_Refinements_, see
+//                   simulateRichardsonPath()
+//
+// Returns:
+//    One accumulator per block of the extrapolated payoffs, so the
+//    variance is that of the combination with the covariances of the
+//    coupled paths in it
+//
+
+template<class Model, class Scheme, class Payoff>
+std::vector<BlockAccumulator> simulateRichardsonBlocks(const SimulationParameters& pP,
+	uint64_t pFirstBlock, uint64_t pLastBlock, uint64_t pSeed, unsigned int pRefinements) {
+
+	auto L = cholesky(pP.rho);
+
+	double weights[_Richardson_Max_Refinements_];
+	richardsonWeights(pRefinements, weights);
+
+	std::vector<BlockAccumulator> result;
+	result.reserve(pLastBlock - pFirstBlock);
+
+	for (auto block = pFirstBlock; block < pLastBlock; block++) {
+		auto accumulator = emptyBlock(block);
+
+		uint64_t firstPath = block * _Partial_Block_Size_;
+		uint64_t lastPath = firstPath + _Partial_Block_Size_;
+		lastPath = (lastPath > pP.sims ? pP.sims : lastPath);
+
+		for (auto path = firstPath; path < lastPath; path++) {
+			auto payoff = simulateRichardsonPath<Model, Scheme, Payoff>(pP, L, pSeed, path, pRefinements, weights);
+			accumulateBlock(&accumulator, payoff, pP.actual);
+		}
+
+		result.push_back(accumulator);
+	}
+
+	return result;
+}
+
+
+//
+// Function: simulateLevelPath()
+//
+// Parameters:
+//    pP - Simulation parameters, pP.steps is the number of steps on
+//         level 0 and level l takes pP.steps 2^l steps
+//    pL - Cholesky factor of pP.rho
+//    pSeed, pPath - Address of the path's random stream
+//    pLevel - Level
+//    pFine, pCoarse - Payoffs of the fine and coarse path, pCoarse is
+//                     0 on level 0
+//
+// Comments:
+//    The coarse path steps with the sum of each pair of fine Brownian
+//    increments, so both paths follow the same Brownian motion.
+//
+
+template<class Model, class Scheme, class Payoff>
+inline void simulateLevelPath(const SimulationParameters& pP,
+	const std::array<std::array<double, 3>, 3>& pL, uint64_t pSeed, uint64_t pPath,
+	unsigned int pLevel, double* pFine, double* pCoarse) {
+
+	PathGenerator generator(pSeed, pPath);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	const unsigned int steps = (pP.steps > 0 ? pP.steps : 1) << pLevel;
+	const unsigned int substeps = (pLevel > 0 ? 2 : 1);
+	const double dt = pP.T / static_cast<double>(steps);
+	const double sqrtdt = sqrt(dt);
+
+	PathState fine = { pP.S0, pP.v0, pP.r0, 0.0 };
+	PathState coarse = fine;
+
+	double Z[Model::Factors], dW[Model::Factors], dWc[Model::Factors];
+
+	for (unsigned int step = 0; step < steps; step += substeps) {
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			dWc[i] = 0.0;
+
+		for (unsigned int sub = 0; sub < substeps; sub++) {
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				Z[i] = normal(generator);
+
+			for (unsigned int i = 0; i < Model::Factors; i++) {
+				dW[i] = 0.0;
+
+				for (unsigned int k = 0; k <= i; k++)
+					dW[i] += pL[i][k] * Z[k];
+
+				dW[i] *= sqrtdt;
+				dWc[i] += dW[i];
+			}
+
+			Model::template step<Scheme>(fine, pP, dW, dt);
+		}
+
+		if (pLevel > 0)
+			Model::template step<Scheme>(coarse, pP, dWc, 2.0 * dt);
+	}
+
+	*pFine = Payoff::value(fine, pP);
+	*pCoarse = (pLevel > 0 ? Payoff::value(coarse, pP) : 0.0);
+}
+
+
+//
+// Function: simulateLevelIncrements()
+//
+// Parameters:
+//    pP - Simulation parameters, see simulateLevelPath()
+//    pdW - Correlated Brownian increments of the fine path,
+//          Model::Factors per step
+//    pLevel - Level
+//    pFine, pCoarse - Payoffs of the fine and coarse path, pCoarse is
+//                     0 on level 0
+//
+// Comments:
+//    simulateLevelPath() with the increments given instead of drawn
+//
+
+template<class Model, class Scheme, class Payoff>
+inline void simulateLevelIncrements(const SimulationParameters& pP, const double* pdW,
+	unsigned int pLevel, double* pFine, double* pCoarse) {
+
+	const unsigned int steps = (pP.steps > 0 ? pP.steps : 1) << pLevel;
+	const unsigned int substeps = (pLevel > 0 ? 2 : 1);
+	const double dt = pP.T / static_cast<double>(steps);
+
+	PathState fine = { pP.S0, pP.v0, pP.r0, 0.0 };
+	PathState coarse = fine;
+
+	double dWc[Model::Factors];
+
+	for (unsigned int step = 0; step < steps; step += substeps) {
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			dWc[i] = 0.0;
+
+		for (unsigned int sub = 0; sub < substeps; sub++) {
+			const double* dW = pdW + (step + sub) * Model::Factors;
+
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				dWc[i] += dW[i];
+
+			Model::template step<Scheme>(fine, pP, dW, dt);
+		}
+
+		if (pLevel > 0)
+			Model::template step<Scheme>(coarse, pP, dWc, 2.0 * dt);
+	}
+
+	*pFine = Payoff::value(fine, pP);
+	*pCoarse = (pLevel > 0 ? Payoff::value(coarse, pP) : 0.0);
+}
+
+
+//
+// Function: adaptiveStep()
+//
+// Parameters:
+//    pX - State at the start of the step
+//    pP - Simulation parameters
+//    pLevel - Level
+//
+// Returns:
+//    h_l(x) = 2^-l h(x), where h(x) is Model::stepLimit() held between
+//    T / steps and T / (steps _Adaptive_Max_Refinement_)
+//
+
+template<class Model>
+inline double adaptiveStep(const PathState& pX, const SimulationParameters& pP, unsigned int pLevel) {
+
+	const double dt = pP.T / static_cast<double>(pP.steps > 0 ? pP.steps : 1);
+	const double h = fmin(dt, fmax(dt / _Adaptive_Max_Refinement_, Model::stepLimit(pX, pP)));
+
+	return ldexp(h, -static_cast<int>(pLevel));
+}
+
+
+//
+// Function: simulateAdaptiveLevelPath()
+//
+// Parameters:
+//    pP - Simulation parameters, see adaptiveStep()
+//    pL - Cholesky factor of pP.rho
+//    pSeed, pPath - Address of the path's random stream
+//    pLevel - Level, the fine path steps with h_l and the coarse path
+//             with h_(l-1)
+//    pFine, pCoarse - Payoffs of the fine and coarse path, pCoarse is
+//                     0 on level 0
+//    pSteps - Incremented by the steps of both paths
+//
+// Comments:
+//    Each path chooses its next step from its own state, so the two
+//    grids are not nested.  Time advances to whichever path steps
+//    next, drawing the Brownian increment since the last such time
+//    and adding it to the increment each path has pending, so both
+//    paths follow the same Brownian motion (Giles, Lester and Whittle
+//    2016).
+//
+
+template<class Model, class Scheme, class Payoff>
+inline void simulateAdaptiveLevelPath(const SimulationParameters& pP,
+	const std::array<std::array<double, 3>, 3>& pL, uint64_t pSeed, uint64_t pPath,
+	unsigned int pLevel, double* pFine, double* pCoarse, double* pSteps) {
+
+	PathGenerator generator(pSeed, pPath);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	PathState fine = { pP.S0, pP.v0, pP.r0, 0.0 };
+	PathState coarse = fine;
+
+	double Z[Model::Factors], dWf[Model::Factors], dWc[Model::Factors];
+
+	for (unsigned int i = 0; i < Model::Factors; i++)
+		dWf[i] = dWc[i] = 0.0;
+
+	// Start and end of the pending step of each path, level 0 has no coarse path
+	double t = 0.0, startf = 0.0, startc = 0.0;
+	double tf = fmin(adaptiveStep<Model>(fine, pP, pLevel), pP.T);
+	double tc = (pLevel > 0 ? fmin(adaptiveStep<Model>(coarse, pP, pLevel - 1), pP.T)
+		: std::numeric_limits<double>::max());
+
+	while (t < pP.T) {
+		double next = fmin(tf, tc);
+		double sqrtdt = sqrt(next - t);
+
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			Z[i] = normal(generator);
+
+		for (unsigned int i = 0; i < Model::Factors; i++) {
+			double dW = 0.0;
+
+			for (unsigned int k = 0; k <= i; k++)
+				dW += pL[i][k] * Z[k];
+
+			dWf[i] += dW * sqrtdt;
+			dWc[i] += dW * sqrtdt;
+		}
+
+		t = next;
+
+		if (t == tf) {
+			Model::template step<Scheme>(fine, pP, dWf, tf - startf);
+			*pSteps += 1.0;
+
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				dWf[i] = 0.0;
+
+			startf = tf;
+			tf = fmin(t + adaptiveStep<Model>(fine, pP, pLevel), pP.T);
+		}
+
+		if (t == tc) {
+			Model::template step<Scheme>(coarse, pP, dWc, tc - startc);
+			*pSteps += 1.0;
+
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				dWc[i] = 0.0;
+
+			startc = tc;
+			tc = fmin(t + adaptiveStep<Model>(coarse, pP, pLevel - 1), pP.T);
+		}
+	}
+
+	*pFine = Payoff::value(fine, pP);
+	*pCoarse = (pLevel > 0 ? Payoff::value(coarse, pP) : 0.0);
+}
+
+
+//
+// Function: simulateAntitheticLevelPath()
+//
+// Parameters:
+//    As simulateLevelPath(), pFine is the mean of the fine path and its
+//    antithetic twin
+//
+// Comments:
+//    The twin takes each pair of fine Brownian increments in the
+//    opposite order.  Both fine paths see the same coarse increment,
+//    and the Levy area terms the Milstein scheme drops cancel to
+//    leading order in their average, which raises the variance decay
+//    of Y_l to beta > 1 for smooth payoffs without simulating them.
+//
+
+template<class Model, class Scheme, class Payoff>
+inline void simulateAntitheticLevelPath(const SimulationParameters& pP,
+	const std::array<std::array<double, 3>, 3>& pL, uint64_t pSeed, uint64_t pPath,
+	unsigned int pLevel, double* pFine, double* pCoarse) {
+
+	if (pLevel == 0) {
+		simulateLevelPath<Model, Scheme, Payoff>(pP, pL, pSeed, pPath, pLevel, pFine, pCoarse);
+		return;
+	}
+
+	PathGenerator generator(pSeed, pPath);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	const unsigned int steps = (pP.steps > 0 ? pP.steps : 1) << pLevel;
+	const double dt = pP.T / static_cast<double>(steps);
+	const double sqrtdt = sqrt(dt);
+
+	PathState fine = { pP.S0, pP.v0, pP.r0, 0.0 };
+	PathState twin = fine;
+	PathState coarse = fine;
+
+	double Z[Model::Factors], dW[2][Model::Factors], dWc[Model::Factors];
+
+	for (unsigned int step = 0; step < steps; step += 2) {
+		for (unsigned int sub = 0; sub < 2; sub++) {
+			for (unsigned int i = 0; i < Model::Factors; i++)
+				Z[i] = normal(generator);
+
+			for (unsigned int i = 0; i < Model::Factors; i++) {
+				dW[sub][i] = 0.0;
+
+				for (unsigned int k = 0; k <= i; k++)
+					dW[sub][i] += pL[i][k] * Z[k];
+
+				dW[sub][i] *= sqrtdt;
+			}
+		}
+
+		for (unsigned int i = 0; i < Model::Factors; i++)
+			dWc[i] = dW[0][i] + dW[1][i];
+
+		Model::template step<Scheme>(fine, pP, dW[0], dt);
+		Model::template step<Scheme>(fine, pP, dW[1], dt);
+
+		Model::template step<Scheme>(twin, pP, dW[1], dt);
+		Model::template step<Scheme>(twin, pP, dW[0], dt);
+
+		Model::template step<Scheme>(coarse, pP, dWc, 2.0 * dt);
+	}
+
+	*pFine = 0.5 * (Payoff::value(fine, pP) + Payoff::value(twin, pP));
+	*pCoarse = Payoff::value(coarse, pP);
+}
+
+
+//
+// Function: simulateLevel()
+//
+// Parameters:
+//    pP - Simulation parameters, see simulateLevelPath()
+//    pLevel - Level
+//    pFirst, pCount - Samples to simulate, addressed by index
+//    pSeed - Seed of the pricing
+//
+// Returns:
+//    Statistics of the samples, the cost counts time steps
+//
+// Comments:
+//    Antithetic uses simulateAntitheticLevelPath(), whose extra fine
+//    path is counted in the cost
+//
+
+template<class Model, class Scheme, class Payoff, bool Antithetic>
+LevelSums simulateLevel(const SimulationParameters& pP, unsigned int pLevel,
+	uint64_t pFirst, uint64_t pCount, uint64_t pSeed) {
+
+	auto L = cholesky(pP.rho);
+	auto seed = levelSeed(pSeed, pLevel);
+	auto sums = emptyLevel();
+
+	for (auto path = pFirst; path < pFirst + pCount; path++) {
+		double fine = 0.0, coarse = 0.0;
+
+		if (Antithetic)
+			simulateAntitheticLevelPath<Model, Scheme, Payoff>(pP, L, seed, path, pLevel, &fine, &coarse);
+		else
+			simulateLevelPath<Model, Scheme, Payoff>(pP, L, seed, path, pLevel, &fine, &coarse);
+
+		accumulateLevel(&sums, fine, coarse);
+	}
+
+	double steps = static_cast<double>((pP.steps > 0 ? pP.steps : 1) << pLevel);
+	double fineCost = (Antithetic ? 2.0 : 1.0) * steps;
+	sums.cost = static_cast<double>(pCount) * (pLevel > 0 ? fineCost + 0.5 * steps : steps);
+
+	return sums;
+}
+
+
+//
+// Function: simulateAdaptiveLevel()
+//
+// Parameters:
+//    pP - Simulation parameters, see adaptiveStep()
+//    pLevel - Level
+//    pFirst, pCount - Samples to simulate, addressed by index
+//    pSeed - Seed of the pricing
+//
+// Returns:
+//    Statistics of the samples, the cost counts the time steps the
+//    paths actually took
+//
+
+template<class Model, class Scheme, class Payoff>
+LevelSums simulateAdaptiveLevel(const SimulationParameters& pP, unsigned int pLevel,
+	uint64_t pFirst, uint64_t pCount, uint64_t pSeed) {
+
+	auto L = cholesky(pP.rho);
+	auto seed = levelSeed(pSeed, pLevel);
+	auto sums = emptyLevel();
+	double steps = 0.0;
+
+	for (auto path = pFirst; path < pFirst + pCount; path++) {
+		double fine = 0.0, coarse = 0.0;
+
+		simulateAdaptiveLevelPath<Model, Scheme, Payoff>(pP, L, seed, path, pLevel, &fine, &coarse, &steps);
+
+		accumulateLevel(&sums, fine, coarse);
+	}
+
+	sums.cost = steps;
+
+	return sums;
+}
+
+
+//
+// Function: simulateQuasiLevel()
+//
+// Parameters:
+//    pP - Simulation parameters, see simulateLevelPath()
+//    pLevel - Level
+//    pRandomization - Randomization of the Sobol points
+//    pFirst, pCount - Points to simulate, addressed by index
+//    pSeed - Seed of the pricing
+//
+// Returns:
+//    Statistics of the points, the cost counts time steps
+//
+// Comments:
+//    A point has Model::Factors coordinates per fine step.  Coordinate
+//    i Factors + f is the i-th normal of factor f's Brownian bridge, so
+//    the end points of every factor come first, then the midpoints,
+//    and so on.  The independent factors are correlated afterwards.
+//
+
+template<class Model, class Scheme, class Payoff>
+LevelSums simulateQuasiLevel(const SimulationParameters& pP, unsigned int pLevel,
+	unsigned int pRandomization, uint64_t pFirst, uint64_t pCount, uint64_t pSeed) {
+
+	const unsigned int F = Model::Factors;
+	const unsigned int steps = (pP.steps > 0 ? pP.steps : 1) << pLevel;
+
+	auto L = cholesky(pP.rho);
+	auto sums = emptyLevel();
+
+	SobolSequence sobol(F * steps, levelSeed(levelSeed(pSeed, pLevel), pRandomization));
+	BrownianBridge bridge(steps, pP.T);
+
+	std::vector<double> u(F * steps), z(steps), W(steps), increments(F * steps), dW(F * steps);
+
+	sobol.skipTo(pFirst);
+
+	for (uint64_t point = 0; point < pCount; point++) {
+		sobol.next(u.data());
+
+		for (unsigned int f = 0; f < F; f++) {
+			for (unsigned int i = 0; i < steps; i++)
+				z[i] = inverseNormal(u[i * F + f]);
+
+			bridge.increments(z.data(), &increments[f * steps], W.data());
+		}
+
+		for (unsigned int step = 0; step < steps; step++)
+			for (unsigned int i = 0; i < F; i++) {
+				double w = 0.0;
+
+				for (unsigned int k = 0; k <= i; k++)
+					w += L[i][k] * increments[k * steps + step];
+
+				dW[step * F + i] = w;
+			}
+
+		double fine = 0.0, coarse = 0.0;
+
+		simulateLevelIncrements<Model, Scheme, Payoff>(pP, dW.data(), pLevel, &fine, &coarse);
+		accumulateLevel(&sums, fine, coarse);
+	}
+
+	double stepCount = static_cast<double>(steps);
+	sums.cost = static_cast<double>(pCount) * (pLevel > 0 ? 1.5 * stepCount : stepCount);
+
+	return sums;
+}
@@ -0,0 +1,123 @@
+
+/*
+ * Path addressed random number generator
+ *
+ * Every Monte Carlo path owns its own stream, seeded from the pair
+ * (seed, path index).  A path therefore draws the same Brownian
+ * increments no matter which process, thread or shard simulates it,
+ * which is what allows a pricing to be split into disjoint slices and
+ * merged back together.
+ *
+ * See also
+ * Blackman, D., Vigna, S. (2021). "Scrambled linear pseudorandom
+ * number generators." ACM Transactions on Mathematical Software,
+ * 47(4), pp. 1-32.
+ *
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     levelSeed() for multilevel Monte Carlo
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <limits>
+
+
+//
+// Function: splitMix64()
+//
+// Parameters:
+//    pState - Generator state, advanced on every call
+//
+// Returns:
+//    Next 64 bit output of the SplitMix64 sequence
+//
+
+static inline uint64_t splitMix64(uint64_t& pState) {
+	uint64_t z = (pState += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+
+//
+// Function: levelSeed()
+//
+// Parameters:
+//    pSeed - Seed of the pricing
+//    pLevel - Multilevel Monte Carlo level
+//
+// Returns:
+//    Seed of the level, so path p of each level is an independent stream
+//
+
+static inline uint64_t levelSeed(uint64_t pSeed, unsigned int pLevel) {
+	uint64_t x = pSeed + 0xA0761D6478BD642FULL * (static_cast<uint64_t>(pLevel) + 1);
+	return splitMix64(x);
+}
+
+
+//
+// Class: PathGenerator
+//
+// Description:
+//    xoshiro256** generator satisfying UniformRandomBitGenerator so it
+//    can drive std::normal_distribution.  The four words of state are
+//    expanded from (seed, path) with SplitMix64, so seeding is cheap
+//    enough to do once per path.
+//
+
+class PathGenerator {
+public:
+	typedef uint64_t result_type;
+
+	PathGenerator(uint64_t pSeed, uint64_t pPath) {
+		uint64_t x = pSeed ^ (pPath * 0xD1B54A32D192ED03ULL);
+
+		for (auto i = 0; i < 4; i++)
+			state[i] = splitMix64(x);
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()() {
+		const uint64_t result = rotl(state[1] * 5, 7) * 9;
+		const uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+
+		return result;
+	}
+
+private:
+	static inline uint64_t rotl(const uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t state[4];
+};
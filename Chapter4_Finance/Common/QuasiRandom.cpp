@@ -0,0 +1,478 @@
+
+/*
+ * Randomized Sobol points and Brownian bridge path construction
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/QuasiRandom.h"
+#include "../Common/PathRandom.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <math.h>
+#include <mutex>
+#include <string>
+
+
+//
+// Initial direction numbers m_1 ... m_s of dimensions 2 to 16 (Joe
+// and Kuo, new-joe-kuo-6.21201)
+//
+
+static const uint32_t joeKuo[15][6] = {
+	{ 1 },
+	{ 1, 3 },
+	{ 1, 3, 1 },
+	{ 1, 1, 1 },
+	{ 1, 1, 3, 3 },
+	{ 1, 3, 5, 13 },
+	{ 1, 1, 5, 5, 17 },
+	{ 1, 1, 5, 5, 5 },
+	{ 1, 1, 7, 11, 19 },
+	{ 1, 1, 5, 1, 1 },
+	{ 1, 1, 1, 3, 11 },
+	{ 1, 3, 5, 5, 31 },
+	{ 1, 3, 3, 9, 7, 49 },
+	{ 1, 1, 1, 15, 21, 21 },
+	{ 1, 3, 1, 13, 27, 49 }
+};
+
+
+//
+// Function: multiplyModulo()
+//
+// Parameters:
+//    pA, pB - Polynomials over GF(2), bit i is the coefficient of x^i
+//    pP - Modulus of degree pDegree
+//
+// Returns:
+//    pA pB mod pP
+//
+
+static uint64_t multiplyModulo(uint64_t pA, uint64_t pB, uint64_t pP, unsigned int pDegree) {
+
+	uint64_t result = 0;
+
+	for (; pB != 0; pB >>= 1) {
+		if (pB & 1)
+			result ^= pA;
+
+		pA <<= 1;
+
+		if (pA & (1ULL << pDegree))
+			pA ^= pP;
+	}
+
+	return result;
+}
+
+
+//
+// Function: powerModulo()
+//
+// Returns:
+//    x^pExponent mod pP
+//
+
+static uint64_t powerModulo(uint64_t pExponent, uint64_t pP, unsigned int pDegree) {
+
+	uint64_t result = 1, base = 2;
+
+	for (; pExponent != 0; pExponent >>= 1) {
+		if (pExponent & 1)
+			result = multiplyModulo(result, base, pP, pDegree);
+
+		base = multiplyModulo(base, base, pP, pDegree);
+	}
+
+	return result;
+}
+
+
+//
+// Function: isPrimitive()
+//
+// Parameters:
+//    pP - Polynomial of degree pDegree with constant term 1
+//
+// Returns:
+//    true if x has order 2^pDegree - 1 modulo pP
+//
+
+static bool isPrimitive(uint64_t pP, unsigned int pDegree) {
+
+	if (pDegree == 1)
+		return true;
+
+	uint64_t order = (1ULL << pDegree) - 1;
+
+	if (powerModulo(order, pP, pDegree) != 1)
+		return false;
+
+	uint64_t remaining = order;
+
+	for (uint64_t q = 2; q * q <= remaining; q++) {
+		if (remaining % q != 0)
+			continue;
+
+		if (powerModulo(order / q, pP, pDegree) == 1)
+			return false;
+
+		while (remaining % q == 0)
+			remaining /= q;
+	}
+
+	if ((remaining > 1) && (powerModulo(order / remaining, pP, pDegree) == 1))
+		return false;
+
+	return true;
+}
+
+
+//
+// Structure: DirectionTable
+//
+// Description:
+//    Unscrambled direction numbers of the dimensions built so far,
+//    extended on demand and shared by every sequence
+//
+
+struct DirectionTable {
+	std::mutex lock;
+	std::vector<uint32_t> v;
+	unsigned int degree = 1;
+	uint64_t candidate = 0;      // Next a to test at this degree
+	uint64_t stream = 0x5DEECE66DULL;
+};
+
+static DirectionTable directionTable;
+
+
+//
+// Function: extendDirections()
+//
+// Parameters:
+//    pTable - Table to extend, locked by the caller
+//    pDimensions - Dimensions needed
+//
+
+static void extendDirections(DirectionTable& pTable, unsigned int pDimensions) {
+
+	auto& v = pTable.v;
+
+	// Dimension 1, van der Corput
+	if (v.empty())
+		for (unsigned int k = 0; k < _Sobol_Bits_; k++)
+			v.push_back(1u << (_Sobol_Bits_ - 1 - k));
+
+	while (v.size() < static_cast<size_t>(pDimensions) * _Sobol_Bits_) {
+		unsigned int s = pTable.degree;
+
+		if (pTable.candidate >= (1ULL << (s - 1))) {
+			pTable.degree++;
+			pTable.candidate = 0;
+			continue;
+		}
+
+		// x^s + a_1 x^(s-1) + ... + a_(s-1) x + 1
+		uint64_t a = pTable.candidate++;
+		uint64_t polynomial = (1ULL << s) | (a << 1) | 1;
+
+		if (!isPrimitive(polynomial, s))
+			continue;
+
+		unsigned int dimension = static_cast<unsigned int>(v.size() / _Sobol_Bits_);
+		uint32_t m[_Sobol_Bits_];
+
+		for (unsigned int k = 0; k < s; k++) {
+			if (dimension - 1 < 15)
+				m[k] = joeKuo[dimension - 1][k];
+			else
+				m[k] = (static_cast<uint32_t>(splitMix64(pTable.stream)) & ((2u << k) - 1)) | 1u;
+		}
+
+		size_t row = v.size();
+		v.resize(row + _Sobol_Bits_);
+
+		for (unsigned int k = 0; k < _Sobol_Bits_; k++) {
+			if (k < s) {
+				v[row + k] = m[k] << (_Sobol_Bits_ - 1 - k);
+				continue;
+			}
+
+			uint32_t w = v[row + k - s] ^ (v[row + k - s] >> s);
+
+			for (unsigned int i = 1; i < s; i++)
+				if ((a >> (s - 1 - i)) & 1)
+					w ^= v[row + k - i];
+
+			v[row + k] = w;
+		}
+	}
+}
+
+
+//
+// Function: SobolSequence()
+//
+// Parameters:
+//    pDimensions - Coordinates per point
+//    pSeed - Seed of the randomization, every seed gives an
+//            independent scrambling and shift
+//
+
+SobolSequence::SobolSequence(unsigned int pDimensions, uint64_t pSeed) :
+	D(pDimensions), index(0), directions(static_cast<size_t>(pDimensions) * _Sobol_Bits_),
+	shift(pDimensions), x(pDimensions, 0) {
+
+	if ((D == 0) || (D > _Sobol_Max_Dimensions_))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Sobol dimensions " + std::to_string(D)
+			+ " outside 1 to " + std::to_string(_Sobol_Max_Dimensions_));
+
+	{
+		std::lock_guard<std::mutex> guard(directionTable.lock);
+
+		extendDirections(directionTable, D);
+		std::copy(directionTable.v.begin(), directionTable.v.begin() + directions.size(), directions.begin());
+	}
+
+	//
+	// Linear scrambling.  Digit p of the result, counted from the most
+	// significant, is digit p of the input plus a random combination
+	// of the more significant digits.
+	//
+
+	PathGenerator generator(pSeed, 0);
+
+	for (unsigned int j = 0; j < D; j++) {
+		uint32_t mask[_Sobol_Bits_];
+
+		for (unsigned int b = 0; b < _Sobol_Bits_; b++) {
+			uint32_t above = static_cast<uint32_t>(~((2ULL << b) - 1));
+			mask[b] = (1u << b) | (static_cast<uint32_t>(generator()) & above);
+		}
+
+		for (unsigned int k = 0; k < _Sobol_Bits_; k++) {
+			uint32_t in = directions[j * _Sobol_Bits_ + k], out = 0;
+
+			for (unsigned int b = 0; b < _Sobol_Bits_; b++)
+				out |= static_cast<uint32_t>(__builtin_parity(in & mask[b])) << b;
+
+			directions[j * _Sobol_Bits_ + k] = out;
+		}
+
+		shift[j] = static_cast<uint32_t>(generator());
+	}
+}
+
+
+//
+// Function: skipTo()
+//
+// Parameters:
+//    pIndex - Index of the next point next() returns
+//
+
+void SobolSequence::skipTo(uint64_t pIndex) {
+
+	if (pIndex >= (1ULL << _Sobol_Bits_))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Sobol index " + std::to_string(pIndex) + " past the period");
+
+	uint64_t gray = pIndex ^ (pIndex >> 1);
+
+	for (unsigned int j = 0; j < D; j++) {
+		uint32_t w = 0;
+
+		for (unsigned int k = 0; k < _Sobol_Bits_; k++)
+			if ((gray >> k) & 1)
+				w ^= directions[j * _Sobol_Bits_ + k];
+
+		x[j] = w;
+	}
+
+	index = pIndex;
+}
+
+
+//
+// Function: next()
+//
+// Parameters:
+//    pU - D coordinates in (0, 1), filled in
+//
+
+void SobolSequence::next(double* pU) {
+
+	for (unsigned int j = 0; j < D; j++)
+		pU[j] = (static_cast<double>(x[j] ^ shift[j]) + 0.5) / 4294967296.0;
+
+	// Gray code order, point index + 1 differs in one direction number
+	unsigned int k = __builtin_ctzll(++index);
+
+	if (k >= _Sobol_Bits_)
+		return;
+
+	for (unsigned int j = 0; j < D; j++)
+		x[j] ^= directions[j * _Sobol_Bits_ + k];
+}
+
+
+//
+// Function: BrownianBridge()
+//
+// Parameters:
+//    pSteps - Number of equal steps
+//    pT - Horizon
+//
+// Comments:
+//    Point i of the construction fixes W at bridgeIndex[i] from its
+//    nearest fixed neighbours, leftIndex[i] - 1 (or time 0 when
+//    leftIndex[i] is 0) and rightIndex[i]
+//
+
+BrownianBridge::BrownianBridge(unsigned int pSteps, double pT) :
+	n(pSteps), leftIndex(pSteps), rightIndex(pSteps), bridgeIndex(pSteps),
+	leftWeight(pSteps), rightWeight(pSteps), stdDev(pSteps) {
+
+	if (n == 0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Brownian bridge needs at least one step");
+
+	std::vector<double> t(n);
+
+	for (unsigned int i = 0; i < n; i++)
+		t[i] = pT * static_cast<double>(i + 1) / static_cast<double>(n);
+
+	std::vector<unsigned int> map(n, 0);
+
+	map[n - 1] = 1;
+	bridgeIndex[0] = n - 1;
+	stdDev[0] = sqrt(t[n - 1]);
+	leftWeight[0] = rightWeight[0] = 0.0;
+
+	unsigned int j = 0;
+
+	for (unsigned int i = 1; i < n; i++) {
+		while (map[j])
+			j++;
+
+		unsigned int k = j;
+
+		while (!map[k])
+			k++;
+
+		unsigned int l = j + ((k - 1 - j) >> 1);
+
+		map[l] = i;
+		bridgeIndex[i] = l;
+		leftIndex[i] = j;
+		rightIndex[i] = k;
+
+		double left = (j > 0 ? t[j - 1] : 0.0);
+
+		leftWeight[i] = (t[k] - t[l]) / (t[k] - left);
+		rightWeight[i] = (t[l] - left) / (t[k] - left);
+		stdDev[i] = sqrt((t[l] - left) * (t[k] - t[l]) / (t[k] - left));
+
+		j = k + 1;
+
+		if (j >= n)
+			j = 0;
+	}
+}
+
+
+//
+// Function: increments()
+//
+// Parameters:
+//    pZ - n independent standard normals, most important first
+//    pdW - n Brownian increments, filled in
+//    pWork - n doubles of scratch space for the path
+//
+
+void BrownianBridge::increments(const double* pZ, double* pdW, double* pWork) const {
+
+	double* W = pWork;
+
+	W[n - 1] = stdDev[0] * pZ[0];
+
+	for (unsigned int i = 1; i < n; i++) {
+		unsigned int j = leftIndex[i];
+		unsigned int k = rightIndex[i];
+		unsigned int l = bridgeIndex[i];
+
+		W[l] = rightWeight[i] * W[k] + stdDev[i] * pZ[i]
+			+ (j > 0 ? leftWeight[i] * W[j - 1] : 0.0);
+	}
+
+	pdW[0] = W[0];
+
+	for (unsigned int i = 1; i < n; i++)
+		pdW[i] = W[i] - W[i - 1];
+}
+
+
+//
+// Function: inverseNormal()
+//
+// Parameters:
+//    pU - Probability in (0, 1)
+//
+// Returns:
+//    x with Phi(x) = pU by Acklam's rational approximation, relative
+//    error below 1.2e-9, far finer than any point set resolves
+//
+
+double inverseNormal(double pU) {
+
+	static const double a[6] = { -3.969683028665376e+01, 2.209460984245205e+02,
+		-2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01,
+		2.506628277459239e+00 };
+	static const double b[5] = { -5.447609879822406e+01, 1.615858368580409e+02,
+		-1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01 };
+	static const double c[6] = { -7.784894002430293e-03, -3.223964580411365e-01,
+		-2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00,
+		2.938163982698783e+00 };
+	static const double d[4] = { 7.784695709041462e-03, 3.224671290700398e-01,
+		2.445134137142996e+00, 3.754408661907416e+00 };
+
+	const double low = 0.02425;
+
+	double x;
+
+	if (pU < low) {
+		double q = sqrt(-2.0 * log(pU));
+		x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+			/ ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+	}
+	else if (pU > 1.0 - low) {
+		double q = sqrt(-2.0 * log(1.0 - pU));
+		x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+			/ ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+	}
+	else {
+		double q = pU - 0.5;
+		double r = q * q;
+		x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+			/ (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+	}
+
+	return x;
+}
@@ -0,0 +1,124 @@
+
+/*
+ * Randomized Sobol points and Brownian bridge path construction
+ *
+ * SobolSequence generates the points of a Sobol sequence in base 2
+ * with Gray code ordering, so any contiguous run of points can be
+ * produced from its first index.  Dimension 1 is van der Corput and
+ * dimension j > 1 follows the j - 1st primitive polynomial over GF(2)
+ * in order of degree.  The first 15 of them take the initial
+ * direction numbers of Joe and Kuo, the rest odd initial numbers drawn
+ * from a fixed stream.
+ *
+ * Each randomization scrambles the direction numbers with a random
+ * lower triangular binary matrix per dimension (Matousek's linear
+ * scrambling) and XORs a random digital shift into every point.  The
+ * randomized points stay a digital net, each one is uniform on the
+ * unit cube and independent randomizations give independent
+ * estimates, whose spread measures the error.
+ *
+ * BrownianBridge turns independent normals into a Brownian path by
+ * fixing the end point first and then filling in midpoints, so the
+ * first coordinates of a point, where Sobol points are most even,
+ * decide the coarse shape of the path.
+ *
+ * See also
+ * Joe, S., Kuo, F.Y. (2008). "Constructing Sobol sequences with
+ * better two-dimensional projections." SIAM Journal on Scientific
+ * Computing, 30(5), pp. 2635-2654.
+ *
+ * Matousek, J. (1998). "On the L2-discrepancy for anchored boxes."
+ * Journal of Complexity, 14(4), pp. 527-556.
+ *
+ * Glasserman, P. (2004). "Monte Carlo Methods in Financial
+ * Engineering." Springer.  Section 3.1.
+ *
+ * Acklam, P.J. (2003). "An algorithm for computing the inverse normal
+ * cumulative distribution function."
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Definitions
+//
+
+// Dimensions with precomputed direction numbers, 3 factors of 2^12 steps
+#define _Sobol_Max_Dimensions_   12288
+#define _Sobol_Bits_             32
+
+
+//
+// Class: SobolSequence
+//
+
+class SobolSequence {
+public:
+	SobolSequence(unsigned int pDimensions, uint64_t pSeed);
+
+	unsigned int dimensions() const { return D; }
+
+	void skipTo(uint64_t pIndex);
+	void next(double* pU);
+
+private:
+	unsigned int D;
+	uint64_t index;
+	std::vector<uint32_t> directions;   // D rows of _Sobol_Bits_
+	std::vector<uint32_t> shift;
+	std::vector<uint32_t> x;            // Current point, unshifted
+};
+
+
+//
+// Class: BrownianBridge
+//
+// Description:
+//    Bridge over pSteps equal steps of a horizon pT.  increments()
+//    maps pSteps independent standard normals, the first deciding
+//    W(T), to the Brownian increments of each step.
+//
+
+class BrownianBridge {
+public:
+	BrownianBridge(unsigned int pSteps, double pT);
+
+	unsigned int steps() const { return n; }
+
+	void increments(const double* pZ, double* pdW, double* pWork) const;
+
+private:
+	unsigned int n;
+	std::vector<unsigned int> leftIndex, rightIndex, bridgeIndex;
+	std::vector<double> leftWeight, rightWeight, stdDev;
+};
+
+
+//
+// Function prototypes
+//
+
+double inverseNormal(double pU);
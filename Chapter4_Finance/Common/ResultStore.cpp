@@ -0,0 +1,284 @@
+
+/*
+ * Columnar binary result store
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/ResultStore.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+//
+// Function: ResultWriter()
+//
+// Parameters:
+//    pFilename - Result file, created if it does not exist
+//
+// Comments:
+//    The header is written under an exclusive flock so that two
+//    workers starting together agree on it.  Appends take no lock.
+//    One writer must not be shared between threads; give each worker
+//    its own.
+//
+
+ResultWriter::ResultWriter(std::string pFilename) :
+	filename(pFilename), fd(-1), header(nullptr),
+	segmentBytes(resultSegmentBytes(_Result_Segment_Rows_)) {
+
+#ifdef __linux__
+	fd = open(pFilename.c_str(), O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	}
+
+	flock(fd, LOCK_EX);
+
+	struct stat status;
+	fstat(fd, &status);
+
+	if (status.st_size == 0) {
+		char page[_Result_Header_Bytes_] = {};
+		ResultHeader initial = {};
+
+		initial.magic = _Result_Magic_;
+		initial.version = _Result_Version_;
+		initial.columns = _RESULT_WIDTH_;
+		initial.segmentRows = _Result_Segment_Rows_;
+		std::memcpy(page, &initial, sizeof(initial));
+
+		if (pwrite(fd, page, sizeof(page), 0) != sizeof(page)) {
+			flock(fd, LOCK_UN);
+			crash(__LINE__, __FILE__, __FUNCTION__, "Unable to write " + pFilename);
+		}
+	}
+
+	flock(fd, LOCK_UN);
+
+	void* address = mmap(nullptr, _Result_Header_Bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (address == MAP_FAILED) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to map " + pFilename);
+	}
+
+	header = static_cast<ResultHeader*>(address);
+
+	if ((header->magic != _Result_Magic_) || (header->version != _Result_Version_) ||
+		(header->columns != _RESULT_WIDTH_) || (header->segmentRows != _Result_Segment_Rows_)) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Not a compatible result file: " + pFilename);
+	}
+#else
+	crash(__LINE__, __FILE__, __FUNCTION__, "The result store needs mmap");
+#endif
+}
+
+
+ResultWriter::~ResultWriter() {
+#ifdef __linux__
+	for (auto s : segments) {
+		if (s != nullptr)
+			munmap(s, segmentBytes);
+	}
+
+	if (header != nullptr)
+		munmap(header, _Result_Header_Bytes_);
+
+	if (fd >= 0)
+		close(fd);
+#endif
+}
+
+
+//
+// Function: segment()
+//
+// Parameters:
+//    pSegment - Segment index
+//
+// Returns:
+//    Shared mapping of the segment, the file is grown to hold it
+//
+
+char* ResultWriter::segment(uint64_t pSegment) {
+
+	if (pSegment < segments.size() && segments[pSegment] != nullptr)
+		return segments[pSegment];
+
+#ifdef __linux__
+	off_t offset = static_cast<off_t>(_Result_Header_Bytes_ + pSegment * segmentBytes);
+
+	// Unlike ftruncate, fallocate never shrinks a file another writer grew
+	if (posix_fallocate(fd, 0, offset + static_cast<off_t>(segmentBytes)) != 0) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to grow " + filename);
+	}
+
+	void* address = mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+
+	if (address == MAP_FAILED) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to map " + filename);
+	}
+
+	if (pSegment >= segments.size())
+		segments.resize(pSegment + 1, nullptr);
+
+	segments[pSegment] = static_cast<char*>(address);
+#endif
+
+	return segments[pSegment];
+}
+
+
+//
+// Function: append()
+//
+// Parameters:
+//    pParameterSet - Id of the parameter set that was priced
+//    pResult - Values indexed by the Results.h slots
+//
+// Returns:
+//    Row the result was written to
+//
+
+uint64_t ResultWriter::append(uint64_t pParameterSet, const double pResult[_RESULT_WIDTH_]) {
+
+	uint64_t row = __atomic_fetch_add(&header->rows, 1, __ATOMIC_ACQ_REL);
+	uint64_t slot = row % _Result_Segment_Rows_;
+
+	auto words = reinterpret_cast<uint64_t*>(segment(row / _Result_Segment_Rows_));
+	auto values = reinterpret_cast<double*>(words + 2 * _Result_Segment_Rows_);
+
+	words[slot] = pParameterSet;
+
+	for (auto c = 0u; c < _RESULT_WIDTH_; c++)
+		values[c * _Result_Segment_Rows_ + slot] = pResult[c];
+
+	// Publish the row only once every column is written
+	__atomic_store_n(&words[_Result_Segment_Rows_ + slot], 1, __ATOMIC_RELEASE);
+
+	return row;
+}
+
+
+//
+// Function: ResultStore()
+//
+// Parameters:
+//    pFilename - Result file written by ResultWriter
+//
+
+ResultStore::ResultStore(std::string pFilename) :
+	file(new MappedFile(pFilename)), available(0), rowsPerSegment(0) {
+
+	ResultHeader header;
+
+	if (file->size() < _Result_Header_Bytes_) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Not a result file: " + pFilename);
+	}
+
+	std::memcpy(&header, file->data(), sizeof(header));
+
+	if ((header.magic != _Result_Magic_) || (header.version != _Result_Version_) ||
+		(header.columns != _RESULT_WIDTH_) || (header.segmentRows == 0)) {
+		crash(__LINE__, __FILE__, __FUNCTION__, "Not a compatible result file: " + pFilename);
+	}
+
+	rowsPerSegment = header.segmentRows;
+
+	// Rows reserved in a segment that is not in the file yet are not readable
+	uint64_t segmentsInFile = (file->size() - _Result_Header_Bytes_) / resultSegmentBytes(rowsPerSegment);
+
+	available = __atomic_load_n(&reinterpret_cast<const ResultHeader*>(file->data())->rows, __ATOMIC_ACQUIRE);
+
+	if (available > segmentsInFile * rowsPerSegment)
+		available = segmentsInFile * rowsPerSegment;
+}
+
+
+//
+// Function: segmentWords()
+//
+
+const uint64_t* ResultStore::segmentWords(uint64_t pSegment) const {
+	return reinterpret_cast<const uint64_t*>(file->data() + _Result_Header_Bytes_
+		+ pSegment * resultSegmentBytes(rowsPerSegment));
+}
+
+
+//
+// Function: committed()
+//
+// Returns:
+//    true once every column of the row has been written
+//
+
+bool ResultStore::committed(uint64_t pRow) const {
+	auto words = segmentWords(pRow / rowsPerSegment);
+	return __atomic_load_n(&words[rowsPerSegment + pRow % rowsPerSegment], __ATOMIC_ACQUIRE) != 0;
+}
+
+
+//
+// Function: parameterSet()
+//
+
+uint64_t ResultStore::parameterSet(uint64_t pRow) const {
+	return segmentWords(pRow / rowsPerSegment)[pRow % rowsPerSegment];
+}
+
+
+//
+// Function: value()
+//
+// Parameters:
+//    pRow - Row
+//    pColumn - Results.h slot
+//
+
+double ResultStore::value(uint64_t pRow, unsigned int pColumn) const {
+	return column(pRow / rowsPerSegment, pColumn)[pRow % rowsPerSegment];
+}
+
+
+//
+// Function: column()
+//
+// Parameters:
+//    pSegment - Segment index
+//    pColumn - Results.h slot
+//
+// Returns:
+//    segmentRows() values of the column, only committed rows are valid
+//
+
+const double* ResultStore::column(uint64_t pSegment, unsigned int pColumn) const {
+	auto words = segmentWords(pSegment);
+	return reinterpret_cast<const double*>(words + 2 * rowsPerSegment) + pColumn * rowsPerSegment;
+}
@@ -0,0 +1,145 @@
+
+/*
+ * Columnar binary result store
+ *
+ * One row per pricing, keyed by parameter set id, with the columns of
+ * Results.h.  The file is a fixed header followed by segments of
+ * _Result_Segment_Rows_ rows.  Inside a segment every column is a
+ * contiguous array, so an analysis tool can map the file and read a
+ * column segment by segment without parsing anything.
+ *
+ * Writers in any number of processes may append to the same file.  A
+ * row is reserved with an atomic add on the row counter in the shared
+ * header, the file is grown with posix_fallocate, which never shrinks
+ * it, and the row is published by setting its committed flag last.
+ * Readers skip rows that are reserved but not yet committed.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Local Includes
+//
+
+#include "../Common/Results.h"
+#include "../Common/MappedFile.h"
+
+
+//
+// Definitions
+//
+
+#define _Result_Magic_          0x53544c5553455248ULL
+#define _Result_Version_        1
+#define _Result_Segment_Rows_   4096
+
+// The header is padded to a page so segments can be mapped on their own
+#define _Result_Header_Bytes_   4096
+
+
+//
+// Structure: ResultHeader
+//
+// Description:
+//    rows counts reserved rows and is only changed with atomic
+//    operations.  A segment holds parameterSet[], committed[] and
+//    then _RESULT_WIDTH_ columns of doubles, each segmentRows long.
+//
+
+struct ResultHeader {
+	uint64_t magic;
+	uint64_t version;
+	uint64_t columns;
+	uint64_t segmentRows;
+	uint64_t rows;
+	uint64_t reserved[3];
+};
+
+
+//
+// Function: resultSegmentBytes()
+//
+
+static inline size_t resultSegmentBytes(uint64_t pSegmentRows) {
+	return static_cast<size_t>(pSegmentRows) * sizeof(uint64_t) * (2 + _RESULT_WIDTH_);
+}
+
+
+//
+// Class: ResultWriter
+//
+
+class ResultWriter {
+public:
+	ResultWriter(std::string pFilename);
+	~ResultWriter();
+
+	ResultWriter(const ResultWriter&) = delete;
+	ResultWriter& operator=(const ResultWriter&) = delete;
+
+	uint64_t append(uint64_t pParameterSet, const double pResult[_RESULT_WIDTH_]);
+
+private:
+	char* segment(uint64_t pSegment);
+
+	std::string filename;
+	int fd;
+	ResultHeader* header;
+	std::vector<char*> segments;
+	size_t segmentBytes;
+};
+
+
+//
+// Class: ResultStore
+//
+// Description:
+//    Read-only view of a result file
+//
+
+class ResultStore {
+public:
+	ResultStore(std::string pFilename);
+
+	uint64_t rows() const { return available; }
+	uint64_t segmentRows() const { return rowsPerSegment; }
+
+	bool committed(uint64_t pRow) const;
+	uint64_t parameterSet(uint64_t pRow) const;
+	double value(uint64_t pRow, unsigned int pColumn) const;
+
+	const double* column(uint64_t pSegment, unsigned int pColumn) const;
+
+private:
+	const uint64_t* segmentWords(uint64_t pSegment) const;
+
+	std::unique_ptr<MappedFile> file;
+	uint64_t available;
+	uint64_t rowsPerSegment;
+};
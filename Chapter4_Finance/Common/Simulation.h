@@ -0,0 +1,72 @@
+
+/*
+ * Single threaded CPU Based Monte Carlo Simulation of European Put
+ * Euler-Muryama Method
+ *
+ * Implementation of
+ * Alexey Medvedev, Olivier Scaillet "Pricing American options under
+ * stochastic volatility and stochastic interest rates"
+ * Journal of Financial Economics. 2010.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2014
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2014-10-07  JJL     Initial version
+ *
+ * 2014-10-20  JJL     Stochastic volatility and
+ *                     stochastic interest rate
+ *
+ * 2014-10-28  JJL     Added Multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     Collected the model parameters that used
+ *                     to be passed positionally to MonteCarlo()
+ *
+ */
+
+#pragma once
+
+//
+// STL Includes
+//
+
+#include <array>
+
+
+//
+// Structure: SimulationParameters
+//
+// Description:
+//    Model and discretization parameters of one pricing.  The GBM
+//    model reads only S0, r0 and v0 (volatility sqrt(v0)), Heston adds
+//    the variance process and HHW adds the interest rate process.
+//
+
+struct SimulationParameters {
+	double S0;       // Initial asset price
+	double v0;       // Initial variance
+	double r0;       // Initial interest rate
+	double T;        // Time to expiry
+	double K;        // Strike price
+	double Kv;       // Mean reversion of variance
+	double Kr;       // Mean reversion of interest rate
+	double sigmav;   // Volatility of variance
+	double sigmar;   // Volatility of interest rate
+	double vbar;     // Long run variance
+	double rbar;     // Long run interest rate
+	double actual;   // Closed form solution, 0.0 if unknown
+
+	unsigned int steps;   // Time steps per path
+	unsigned int sims;    // Number of paths
+
+	std::array<std::array<double, 3>, 3> rho;   // Correlation of (S, v, r)
+};
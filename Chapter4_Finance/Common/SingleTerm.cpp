@@ -0,0 +1,281 @@
+
+/*
+ * Randomized single term multilevel Monte Carlo driver
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Levels with no pilot signal drawn on the
+ *                     geometric profile instead of evenly
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/SingleTerm.h"
+#include "../Common/PathRandom.h"
+#include "../Common/WorkStealing.h"
+#include "../Common/Welford.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <algorithm>
+#include <math.h>
+#include <string>
+
+
+//
+// Structure: SingleTermBlock
+//
+// Description:
+//    Statistics of Z over the samples of one block and the number of
+//    samples that drew each level
+//
+
+struct SingleTermBlock {
+	double count;
+	double mean;
+	double M2;
+	double cost;
+	std::vector<double> drawn;
+};
+
+
+//
+// Function: levelProbabilities()
+//
+// Parameters:
+//    pPilot - Statistics of the pilot levels
+//    pBeta, pGamma - Rates used above the pilot levels
+//    pMaxLevel - Finest level that can be drawn
+//
+// Returns:
+//    p_l proportional to sqrt(E[Y_l^2] / C_l), measured on the pilot
+//    levels and extrapolated from the finest of them
+//
+// Comments:
+//    A level whose pilot samples were all 0 must still be drawn.  It
+//    gets the geometric profile 2^(-(beta + gamma) l / 2) through the
+//    largest measured level, or through level 0 at 1 when none was
+//    measured, so a payoff that is 0 on every pilot path draws the
+//    fine levels no more often than the rates allow.
+//
+
+static std::vector<double> levelProbabilities(const std::vector<LevelSums>& pPilot,
+	double pBeta, double pGamma, unsigned int pMaxLevel) {
+
+	std::vector<double> p(pMaxLevel + 1);
+	double scale = 0.0;
+
+	for (size_t l = 0; l < p.size(); l++) {
+		auto k = std::min(l, pPilot.size() - 1);
+		auto& sums = pPilot[k];
+
+		double second = levelVariance(sums) + sums.mean * sums.mean;
+		double cost = sums.cost / sums.count;
+		double above = static_cast<double>(l - k);
+
+		p[l] = sqrt(second / cost) * pow(2.0, -0.5 * (pBeta + pGamma) * above);
+
+		if (p[l] > 0.0)
+			scale = std::max(scale, p[l] * pow(2.0, 0.5 * (pBeta + pGamma) * static_cast<double>(l)));
+	}
+
+	if (scale == 0.0)
+		scale = 1.0;
+
+	double total = 0.0;
+
+	for (size_t l = 0; l < p.size(); l++) {
+		if (!(p[l] > 0.0))
+			p[l] = scale * pow(2.0, -0.5 * (pBeta + pGamma) * static_cast<double>(l));
+
+		total += p[l];
+	}
+
+	for (auto& x : p)
+		x /= total;
+
+	return p;
+}
+
+
+//
+// Function: sampleBlock()
+//
+// Parameters:
+//    pEstimator - Sampler of the levels
+//    pProbabilities - p_l
+//    pCumulative - Running sum of p_l
+//    pBlock - Block to sample
+//    pFirst - Sample index of the first block on every level
+//    pSeed - Seed of the level draws
+//
+// Returns:
+//    Statistics of Z over the block.  A level drawn n times is sampled
+//    once with n samples, and the group of its samples contributes
+//    mean E[Y_l] / p_l and sum of squares M2_l / p_l^2 to the block.
+//
+
+static SingleTermBlock sampleBlock(const LevelEstimator& pEstimator,
+	const std::vector<double>& pProbabilities, const std::vector<double>& pCumulative,
+	uint64_t pBlock, uint64_t pFirst, uint64_t pSeed) {
+
+	SingleTermBlock block = { 0.0, 0.0, 0.0, 0.0, std::vector<double>(pProbabilities.size(), 0.0) };
+
+	PathGenerator generator(levelSeed(pSeed, static_cast<unsigned int>(pProbabilities.size())), pBlock);
+
+	for (auto i = 0; i < _Single_Term_Block_Size_; i++) {
+		double u = static_cast<double>(generator() >> 11) * 0x1.0p-53;
+		auto l = std::upper_bound(pCumulative.begin(), pCumulative.end() - 1, u) - pCumulative.begin();
+
+		block.drawn[l]++;
+	}
+
+	auto first = pFirst + pBlock * _Single_Term_Block_Size_;
+
+	for (size_t l = 0; l < block.drawn.size(); l++) {
+		if (block.drawn[l] == 0.0)
+			continue;
+
+		auto sums = pEstimator(static_cast<unsigned int>(l), first, static_cast<uint64_t>(block.drawn[l]));
+		auto p = pProbabilities[l];
+
+		welfordMerge(&block.count, &block.mean, &block.M2, sums.count, sums.mean / p, sums.M2 / (p * p));
+		block.cost += sums.cost;
+	}
+
+	return block;
+}
+
+
+//
+// Function: singleTermMonteCarlo()
+//
+// Parameters:
+//    pEstimator - Sampler of the levels
+//    pOptions - Target standard error, pilot, level limit, seed and
+//               threads
+//
+// Returns:
+//    Estimate of E[P_L] for L = maxLevel, its variance and the level
+//    distribution it was drawn from
+//
+
+SingleTermResult singleTermMonteCarlo(const LevelEstimator& pEstimator, const SingleTermOptions& pOptions) {
+
+	if (pOptions.eps <= 0.0)
+		crash(__LINE__, __FILE__, __FUNCTION__, "Target RMSE must be positive");
+
+	if ((pOptions.pilotLevels < 3) || (pOptions.maxLevel + 1 < pOptions.pilotLevels) || (pOptions.pilot < 2))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Invalid single term options: "
+			+ std::to_string(pOptions.pilotLevels) + " pilot levels to level "
+			+ std::to_string(pOptions.maxLevel));
+
+	SingleTermResult result;
+	WorkStealingPool pool(pOptions.threads);
+
+	//
+	// Pilot for the level distribution
+	//
+
+	result.pilot.assign(pOptions.pilotLevels, emptyLevel());
+
+	std::vector<double> dN(pOptions.pilotLevels, static_cast<double>(pOptions.pilot));
+	std::vector<double> C(pOptions.pilotLevels);
+
+	for (size_t l = 0; l < C.size(); l++)
+		C[l] = pow(2.0, static_cast<double>(l));
+
+	sampleLevels(pEstimator, pool, &result.pilot, dN, C);
+
+	std::vector<double> V(C.size());
+
+	result.cost = 0.0;
+
+	for (size_t l = 0; l < C.size(); l++) {
+		auto& sums = result.pilot[l];
+
+		if (sums.cost <= 0.0)
+			crash(__LINE__, __FILE__, __FUNCTION__, "Level " + std::to_string(l) + " reported no cost");
+
+		V[l] = levelVariance(sums);
+		C[l] = sums.cost / sums.count;
+		result.cost += sums.cost;
+	}
+
+	result.beta = (pOptions.beta > 0.0 ? pOptions.beta : std::max(0.5, -regressionSlope(V)));
+	result.gamma = (pOptions.gamma > 0.0 ? pOptions.gamma : std::max(0.5, regressionSlope(C)));
+
+	result.probabilities = levelProbabilities(result.pilot, result.beta, result.gamma, pOptions.maxLevel);
+
+	std::vector<double> cumulative(result.probabilities.size());
+	double running = 0.0;
+
+	for (size_t l = 0; l < cumulative.size(); l++) {
+		running += result.probabilities[l];
+		cumulative[l] = running;
+	}
+
+	//
+	// Rounds of blocks until the standard error is on target.  Sample
+	// indices start after the pilot so its paths are not reused.
+	//
+
+	double count = 0.0, mean = 0.0, M2 = 0.0;
+	uint64_t next = 0;
+	uint64_t blocks = _Single_Term_First_Blocks_;
+
+	result.drawn.assign(result.probabilities.size(), 0.0);
+
+	for (;;) {
+		std::vector<SingleTermBlock> round(blocks);
+
+		pool.run(blocks, [&](size_t ptask) {
+			round[ptask] = sampleBlock(pEstimator, result.probabilities, cumulative,
+				next + ptask, pOptions.pilot, pOptions.seed);
+		});
+
+		for (auto& block : round) {
+			welfordMerge(&count, &mean, &M2, block.count, block.mean, block.M2);
+			result.cost += block.cost;
+
+			for (size_t l = 0; l < block.drawn.size(); l++)
+				result.drawn[l] += block.drawn[l];
+		}
+
+		next += blocks;
+
+		double variance = welfordVariance(&count, &mean, &M2);
+
+		if (variance / count <= pOptions.eps * pOptions.eps)
+			break;
+
+		//
+		// Aim a tenth past the samples the variance asks for, at most
+		// four times the samples so far while it is still settling
+		//
+
+		double target = std::min(1.1 * variance / (pOptions.eps * pOptions.eps), 4.0 * count);
+
+		blocks = std::max<uint64_t>(1, static_cast<uint64_t>(ceil((target - count) / _Single_Term_Block_Size_)));
+	}
+
+	result.estimate = mean;
+	result.samples = count;
+	result.variance = welfordVariance(&count, &mean, &M2) / count;
+
+	return result;
+}
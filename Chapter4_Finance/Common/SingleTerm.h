@@ -0,0 +1,134 @@
+
+/*
+ * Randomized single term multilevel Monte Carlo driver
+ *
+ * Every sample draws its own level l with probability p_l and returns
+ *
+ *    Z = Y_l / p_l
+ *
+ * where Y_l = P_l - P_(l-1) is the fine minus coarse sample of that
+ * level.  E[Z] = sum_l p_l E[Y_l] / p_l = E[P_L], so the samples are
+ * independent, identically distributed and unbiased up to the finest
+ * level L that can be drawn.  There are no levels to keep in step and
+ * no bias test: the driver is plain Monte Carlo on Z, stopping when
+ * the standard error of the mean is below the target.
+ *
+ * The product of the variance of Z and its expected cost is smallest
+ * for p_l proportional to sqrt(E[Y_l^2] / C_l).  A pilot measures
+ * E[Y_l^2] and C_l on the first levels, regresses the rates
+ * V_l ~ 2^(-beta l) and C_l ~ 2^(gamma l), and extrapolates them to
+ * the levels above, so p_l falls as 2^(-(beta + gamma) l / 2).  Both
+ * the variance and the cost stay bounded as L grows only when
+ * beta > gamma, which makes L a formality: with the default of 20 the
+ * levels that are never drawn are below anything the samples can
+ * resolve.  With beta <= gamma, Euler on a rough payoff, the estimator
+ * is still unbiased but its work grows with L.
+ *
+ * Samples run in blocks of fixed size.  A block draws the levels of
+ * its samples from a stream addressed by the block, counts them per
+ * level and calls the level estimator once per level drawn, with
+ * sample indices that no other block uses.  The statistics of Z in a
+ * block follow exactly from the per level sums, and the blocks are
+ * merged in block order once a round is over, so the answer does not
+ * depend on the number of threads.  Blocks are addressed by index and
+ * share nothing, so a range of them can run anywhere.
+ *
+ * See also
+ * Rhee, C.H., Glynn, P.W. (2015). "Unbiased estimation with square
+ * root convergence for SDE models." Operations Research, 63(5),
+ * pp. 1026-1043.
+ *
+ * Giles, M.B. (2015). "Multilevel Monte Carlo methods." Acta
+ * Numerica, 24, pp. 259-328, section 2.5.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#pragma once
+
+//
+// Local Includes
+//
+
+#include "../Common/MLMC.h"
+
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Definitions
+//
+
+#define _Single_Term_Max_Level_      20
+#define _Single_Term_Pilot_Levels_   4
+#define _Single_Term_Block_Size_     1024
+
+// Blocks in the first round, later rounds are sized from the variance
+#define _Single_Term_First_Blocks_   64
+
+
+//
+// Structure: SingleTermOptions
+//
+// Description:
+//    eps is the target standard error of the estimate, which is its
+//    root mean square error as the estimate is unbiased.  pilot
+//    samples are taken on each of pilotLevels levels.  beta and gamma
+//    of 0 are estimated by the pilot, positive values are used as
+//    given.  seed addresses the level draws.  threads of 0 is one per
+//    core.
+//
+
+struct SingleTermOptions {
+	double eps;
+	uint64_t seed = 0;
+	uint64_t pilot = _MLMC_Pilot_Samples_;
+	unsigned int pilotLevels = _Single_Term_Pilot_Levels_;
+	unsigned int maxLevel = _Single_Term_Max_Level_;
+	double beta = 0.0;
+	double gamma = 0.0;
+	unsigned int threads = 0;
+};
+
+
+//
+// Structure: SingleTermResult
+//
+
+struct SingleTermResult {
+	double estimate;
+	double variance;                    // Variance of the estimate
+	double samples;
+	double cost;                        // Pilot included
+	double beta;
+	double gamma;
+	std::vector<double> probabilities;  // p_l, levels 0 ... maxLevel
+	std::vector<double> drawn;          // Samples that drew each level
+	std::vector<LevelSums> pilot;       // Statistics of the pilot levels
+};
+
+
+//
+// Function prototypes
+//
+
+SingleTermResult singleTermMonteCarlo(const LevelEstimator& pEstimator, const SingleTermOptions& pOptions);
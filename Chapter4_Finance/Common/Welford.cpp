@@ -22,6 +22,13 @@
  * ----------  ------  ---------------
  * 2018-12-16  JJL     Initial version
  *
+ * 2026-10-19  JJL     Added welfordMerge() using the pairwise
+ *                     update of Chan, Golub and LeVeque (1979)
+ *
+ * 2026-10-19  JJL     Added welfordMoments() and welfordMomentsMerge()
+ *                     carrying the third and fourth central moments,
+ *                     after Pebay (2008)
+ *
  */
 
 
@@ -38,3 +45,95 @@ double welfordVariance(double* pCount, double* pMean, double* pM2) {
 	return *pM2 / (*pCount - 1);
 }
 
+
+//
+// Function: welfordMerge()
+//
+// Parameters:
+//    pCount, pMean, pM2 - Running statistics, updated in place
+//    pCountB, pMeanB, pM2B - Statistics of a second, disjoint sample
+//
+// Returns:
+//    Nothing
+//
+// Comments:
+//    The result depends on the order of the merges, so callers that
+//    need reproducible answers must always merge in the same order.
+//
+
+void welfordMerge(double* pCount, double* pMean, double* pM2,
+	double pCountB, double pMeanB, double pM2B) {
+
+	if (pCountB == 0.0)
+		return;
+
+	double count = *pCount + pCountB;
+	double delta = pMeanB - *pMean;
+
+	*pMean += delta * pCountB / count;
+	*pM2 += pM2B + delta * delta * (*pCount) * pCountB / count;
+	*pCount = count;
+}
+
+
+//
+// Function: welfordMoments()
+//
+// Parameters:
+//    pCount, pMean, pM2 - As welford()
+//    pM3, pM4 - Sums of cubed and fourth powers of the deviations
+//    pNewValue - Value to add
+//
+// Returns:
+//    Nothing, the kurtosis is pCount pM4 / pM2^2
+//
+
+void welfordMoments(double* pCount, double* pMean, double* pM2, double* pM3, double* pM4,
+	double pNewValue) {
+
+	double n1 = *pCount;
+	double n = n1 + 1.0;
+	double delta = pNewValue - *pMean;
+	double deltaN = delta / n;
+	double deltaN2 = deltaN * deltaN;
+	double term = delta * deltaN * n1;
+
+	*pMean += deltaN;
+	*pM4 += term * deltaN2 * (n * n - 3.0 * n + 3.0) + 6.0 * deltaN2 * (*pM2) - 4.0 * deltaN * (*pM3);
+	*pM3 += term * deltaN * (n - 2.0) - 3.0 * deltaN * (*pM2);
+	*pM2 += term;
+	*pCount = n;
+}
+
+
+//
+// Function: welfordMomentsMerge()
+//
+// Parameters:
+//    pCount, pMean, pM2, pM3, pM4 - Running statistics, updated in place
+//    pCountB ... pM4B - Statistics of a second, disjoint sample
+//
+// Returns:
+//    Nothing
+//
+
+void welfordMomentsMerge(double* pCount, double* pMean, double* pM2, double* pM3, double* pM4,
+	double pCountB, double pMeanB, double pM2B, double pM3B, double pM4B) {
+
+	if (pCountB == 0.0)
+		return;
+
+	double nA = *pCount, nB = pCountB;
+	double n = nA + nB;
+	double delta = pMeanB - *pMean;
+	double delta2 = delta * delta;
+
+	*pM4 += pM4B + delta2 * delta2 * nA * nB * (nA * nA - nA * nB + nB * nB) / (n * n * n)
+		+ 6.0 * delta2 * (nA * nA * pM2B + nB * nB * (*pM2)) / (n * n)
+		+ 4.0 * delta * (nA * pM3B - nB * (*pM3)) / n;
+	*pM3 += pM3B + delta2 * delta * nA * nB * (nA - nB) / (n * n)
+		+ 3.0 * delta * (nA * pM2B - nB * (*pM2)) / n;
+	*pM2 += pM2B + delta2 * nA * nB / n;
+	*pMean += delta * nB / n;
+	*pCount = n;
+}
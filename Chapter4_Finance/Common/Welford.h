@@ -17,10 +17,21 @@
  * ----------  ------  ---------------
  * 2018-12-16  JJL     Initial version
  *
+ * 2026-10-19  JJL     Added welfordMerge() for combining
+ *                     partial results
+ *
+ * 2026-10-19  JJL     Added welfordMoments() and welfordMomentsMerge()
+ *                     for the kurtosis
+ *
  */
 
 #pragma once
 
 void welford(double* pcount, double* pmean, double* pM2, double pNewValue);
 double welfordVariance(double* pCount, double* pMean, double* pM2);
-
+void welfordMerge(double* pCount, double* pMean, double* pM2,
+	double pCountB, double pMeanB, double pM2B);
+void welfordMoments(double* pCount, double* pMean, double* pM2, double* pM3, double* pM4,
+	double pNewValue);
+void welfordMomentsMerge(double* pCount, double* pMean, double* pM2, double* pM3, double* pM4,
+	double pCountB, double pMeanB, double pM2B, double pM3B, double pM4B);
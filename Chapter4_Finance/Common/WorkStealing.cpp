@@ -0,0 +1,237 @@
+
+/*
+ * Work stealing pool for rounds of independent tasks
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ * 2026-10-19  JJL     Workers kept alive across rounds
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/WorkStealing.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <limits>
+#include <string>
+
+
+//
+// Function: WorkStealingPool()
+//
+// Parameters:
+//    pThreads - Number of workers, 0 for one per core.  The calling
+//               thread is worker 0, the others are started here and
+//               wait for the first round.
+//
+
+WorkStealingPool::WorkStealingPool(unsigned int pThreads) :
+	workers(pThreads), stolen(0), task(nullptr), round(0), active(0), pending(0),
+	stopping(false) {
+
+	if (workers == 0)
+		workers = std::thread::hardware_concurrency();
+
+	if (workers == 0)
+		workers = 1;
+
+	queues.reset(new TaskQueue[workers]);
+
+	for (unsigned int w = 1; w < workers; w++)
+		helpers.emplace_back(&WorkStealingPool::serve, this, w);
+}
+
+
+//
+// Function: ~WorkStealingPool()
+//
+
+WorkStealingPool::~WorkStealingPool() {
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+
+	started.notify_all();
+
+	for (auto& helper : helpers)
+		helper.join();
+}
+
+
+//
+// Function: takeFront()
+//
+// Returns:
+//    false if the queue is empty
+//
+
+bool WorkStealingPool::takeFront(TaskQueue& pQueue, uint32_t* pTask) {
+
+	auto range = pQueue.range.load(std::memory_order_acquire);
+
+	for (;;) {
+		uint64_t front = range >> 32;
+		uint64_t back = range & 0xFFFFFFFFULL;
+
+		if (front >= back)
+			return false;
+
+		if (pQueue.range.compare_exchange_weak(range, ((front + 1) << 32) | back,
+			std::memory_order_acq_rel, std::memory_order_acquire)) {
+			*pTask = pQueue.tasks[front];
+			return true;
+		}
+	}
+}
+
+
+//
+// Function: takeBack()
+//
+
+bool WorkStealingPool::takeBack(TaskQueue& pQueue, uint32_t* pTask) {
+
+	auto range = pQueue.range.load(std::memory_order_acquire);
+
+	for (;;) {
+		uint64_t front = range >> 32;
+		uint64_t back = range & 0xFFFFFFFFULL;
+
+		if (front >= back)
+			return false;
+
+		if (pQueue.range.compare_exchange_weak(range, (front << 32) | (back - 1),
+			std::memory_order_acq_rel, std::memory_order_acquire)) {
+			*pTask = pQueue.tasks[back - 1];
+			return true;
+		}
+	}
+}
+
+
+//
+// Function: work()
+//
+// Description:
+//    Own queue first, then the others in turn starting with the next
+//    worker, until every queue is empty
+//
+
+void WorkStealingPool::work(unsigned int pWorker, const std::function<void(size_t)>& pTask) {
+
+	uint32_t task = 0;
+
+	while (takeFront(queues[pWorker], &task))
+		pTask(task);
+
+	for (unsigned int i = 1; i < workers; i++) {
+		auto& victim = queues[(pWorker + i) % workers];
+
+		while (takeBack(victim, &task)) {
+			stolen.fetch_add(1, std::memory_order_relaxed);
+			pTask(task);
+		}
+	}
+}
+
+
+//
+// Function: serve()
+//
+// Parameters:
+//    pWorker - Helper thread's worker number, 1 ... workers - 1
+//
+// Description:
+//    Waits for each new round, works it if the worker is one of the
+//    round's active ones and checks in at the barrier either way
+//
+
+void WorkStealingPool::serve(unsigned int pWorker) {
+
+	uint64_t seen = 0;
+
+	std::unique_lock<std::mutex> guard(lock);
+
+	for (;;) {
+		started.wait(guard, [&] { return stopping || round != seen; });
+
+		if (stopping)
+			return;
+
+		seen = round;
+
+		if (pWorker < active) {
+			auto* current = task;
+
+			guard.unlock();
+			work(pWorker, *current);
+			guard.lock();
+		}
+
+		if (--pending == 0)
+			finished.notify_one();
+	}
+}
+
+
+//
+// Function: run()
+//
+// Parameters:
+//    pTasks - Number of tasks, numbered 0 ... pTasks - 1 in the order
+//             they should be started
+//    pTask - Executes one task, called concurrently from every worker
+//
+// Returns:
+//    Once every task has finished
+//
+
+void WorkStealingPool::run(size_t pTasks, const std::function<void(size_t)>& pTask) {
+
+	if (pTasks > std::numeric_limits<uint32_t>::max())
+		crash(__LINE__, __FILE__, __FUNCTION__, "Too many tasks in one round: " + std::to_string(pTasks));
+
+	for (unsigned int w = 0; w < workers; w++)
+		queues[w].tasks.clear();
+
+	for (size_t t = 0; t < pTasks; t++)
+		queues[t % workers].tasks.push_back(static_cast<uint32_t>(t));
+
+	for (unsigned int w = 0; w < workers; w++)
+		queues[w].range.store(queues[w].tasks.size(), std::memory_order_release);
+
+	// No more workers than tasks, a worker with nothing to do would only steal
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		task = &pTask;
+		active = (pTasks < workers ? static_cast<unsigned int>(pTasks) : workers);
+		pending = workers - 1;
+		round++;
+	}
+
+	started.notify_all();
+
+	if (pTasks > 0)
+		work(0, pTask);
+
+	// Barrier, pTask and the queues must outlive every helper's share
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [&] { return pending == 0; });
+	task = nullptr;
+}
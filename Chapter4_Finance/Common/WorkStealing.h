@@ -0,0 +1,108 @@
+
+/*
+ * Work stealing pool for rounds of independent tasks
+ *
+ * run() executes a known list of tasks.  The tasks are dealt round
+ * robin onto one queue per worker in the order given, so a caller that
+ * sorts them by decreasing cost hands every worker a share of the
+ * expensive ones first.  A worker takes tasks from the front of its
+ * own queue and, once it is empty, steals from the back of the others,
+ * so the cheap tasks at the back fill the gaps until the round ends.
+ *
+ * The task list of a round never grows, so a queue is a fixed array
+ * and the front and back indices are packed into one atomic word that
+ * owner and thieves advance with compare and swap.  No locks are
+ * taken.
+ *
+ * The workers are started once by the constructor and stay alive
+ * between rounds.  run() publishes a new round under a mutex, wakes
+ * them and, after doing its own share as worker 0, waits on a per
+ * round barrier until every worker has checked back in.  The
+ * destructor stops and joins them.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ * 2026-10-19  JJL     Workers kept alive across rounds
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+//
+// STL Includes
+//
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//
+// Class: WorkStealingPool
+//
+
+class WorkStealingPool {
+public:
+	WorkStealingPool(unsigned int pThreads = 0);
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	unsigned int threads() const { return workers; }
+
+	void run(size_t pTasks, const std::function<void(size_t)>& pTask);
+
+	uint64_t steals() const { return stolen; }
+
+private:
+	//
+	// Structure: TaskQueue
+	//
+	// Description:
+	//    range holds front in the high and back in the low 32 bits,
+	//    padded to a cache line so queues do not share one
+	//
+
+	struct alignas(64) TaskQueue {
+		std::vector<uint32_t> tasks;
+		std::atomic<uint64_t> range;
+	};
+
+	bool takeFront(TaskQueue& pQueue, uint32_t* pTask);
+	bool takeBack(TaskQueue& pQueue, uint32_t* pTask);
+	void work(unsigned int pWorker, const std::function<void(size_t)>& pTask);
+	void serve(unsigned int pWorker);
+
+	unsigned int workers;
+	std::unique_ptr<TaskQueue[]> queues;
+	std::atomic<uint64_t> stolen;
+
+	// Round hand off to the helper threads, guarded by lock
+	std::vector<std::thread> helpers;
+	std::mutex lock;
+	std::condition_variable started;
+	std::condition_variable finished;
+	const std::function<void(size_t)>* task;
+	uint64_t round;
+	unsigned int active;
+	unsigned int pending;
+	bool stopping;
+};
@@ -28,63 +28,68 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Initial version of cholesky()
+ *
  */
 
 
 //
-// Local Includes
+// STL Includes
 //
 
-#include "Crash.h"
-#include "Trim.h"
+#include <array>
 
 
 //
 // Standard Includes
 //
 
-#include <string>
-#include <fstream>
-#include <iostream>
+#include <math.h>
 
 
 //
-// STL Includes
+// Local Includes
 //
 
-#include <vector>
+#include "../Common/Crash.h"
 
 
 //
-// Function: importRawData()
+// Function: cholesky()
 //
 // Parameters:
+//    pmatrix - Symmetric positive definite matrix, usually from
+//              createMatrix()
 //
 // Returns:
+//    Lower triangular L with L * L^T = pmatrix
 //
 
-std::vector<std::string> importRawData(std::string pFilename) {
+std::array<std::array<double, 3>, 3> cholesky(std::array<std::array<double, 3>, 3> pmatrix) {
 
-	std::ifstream inFile(pFilename, std::ios::in);
+	std::array<std::array<double, 3>, 3> L;
 
-	if (!inFile.is_open()) {
-		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
-	}
+	for (auto i = 0; i < 3; i++)
+		for (auto j = 0; j < 3; j++)
+			L[i][j] = 0.0;
 
-	std::vector<std::string> rawData;
+	for (auto i = 0; i < 3; i++) {
+		for (auto j = 0; j <= i; j++) {
+			double sum = pmatrix[i][j];
 
-	std::string line;
+			for (auto k = 0; k < j; k++)
+				sum -= L[i][k] * L[j][k];
 
-	while (std::getline(inFile, line)) {
-		trim(line);
+			if (i == j) {
+				if (sum <= 0.0)
+					crash(__LINE__, __FILE__, __FUNCTION__, "Correlation matrix is not positive definite");
 
-		if (line.size() > 0)
-			rawData.push_back(line);
+				L[i][i] = sqrt(sum);
+			}
+			else
+				L[i][j] = sum / L[j][j];
+		}
 	}
 
-	std::cout << "Imported " << rawData.size() << " rows from the file" << std::endl;
-
-	return rawData;
+	return L;
 }
-
-
@@ -28,17 +28,17 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Initial version of cholesky()
+ *
  */
 
 #pragma once
 
-
 //
 // STL Includes
 //
 
-#include <vector>
-
+#include <array>
 
-std::vector<std::vector<double>> importParameters();
 
+std::array<std::array<double, 3>, 3> cholesky(std::array<std::array<double, 3>, 3> pmatrix);
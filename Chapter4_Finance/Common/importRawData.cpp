@@ -28,6 +28,20 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Row count logged at debug level
+ *
+ * 2026-10-19  JJL     Memory mapped RawData, rows and fields are
+ *                     views into the mapping, chunks are trimmed
+ *                     and tokenized in parallel
+ *
+ * 2026-10-19  JJL     Mapping moved to MappedFile
+ *
+ * 2026-10-19  JJL     Fields tokenized on access, only their counts
+ *                     are kept
+ *
+ * 2026-10-19  JJL     Field counts taken on access too, the chunk
+ *                     threads only find the rows
+ *
  */
 
 
@@ -35,8 +49,9 @@
 // Local Includes
 //
 
-#include "../Common/Crash.h"
-#include "../Common/Trim.h"
+#include "../Common/importRawData.h"
+#include "../Common/parseRow.h"
+#include "../Common/Log.h"
 
 
 //
@@ -44,8 +59,8 @@
 //
 
 #include <string>
-#include <fstream>
-#include <iostream>
+#include <string_view>
+#include <thread>
 
 
 //
@@ -56,35 +71,200 @@
 
 
 //
-// Function: importRawData()
+// Definitions
+//
+
+// Smallest chunk worth a thread of its own
+#define _Chunk_Minimum_   (4 * 1024 * 1024)
+
+
+//
+// Function: trimRow()
+//
+// Description:
+//    Same whitespace as std::isspace, which trim() uses
+//
+
+static inline std::string_view trimRow(std::string_view pRow) {
+
+	const char* whitespace = " \t\r\n\f\v";
+
+	auto first = pRow.find_first_not_of(whitespace);
+
+	if (first == std::string_view::npos)
+		return std::string_view();
+
+	auto last = pRow.find_last_not_of(whitespace);
+
+	return pRow.substr(first, last - first + 1);
+}
+
+
+//
+// Function: indexChunk()
 //
 // Parameters:
+//    pChunk - Newline aligned part of the file
+//    pRows - Filled with the non-empty rows of the chunk
 //
-// Returns:
+
+static void indexChunk(std::string_view pChunk, std::vector<std::string_view>* pRows) {
+
+	size_t position = 0;
+
+	while (position < pChunk.size()) {
+		auto end = pChunk.find('\n', position);
+
+		if (end == std::string_view::npos)
+			end = pChunk.size();
+
+		auto row = trimRow(pChunk.substr(position, end - position));
+		position = end + 1;
+
+		if (row.empty())
+			continue;
+
+		pRows->push_back(row);
+	}
+}
+
+
+//
+// Function: RawData()
+//
+// Parameters:
+//    pFilename - Text file
+//    pThreads - Worker threads, 0 for one per core
 //
 
-std::vector<std::string> importRawData(std::string pFilename) {
+RawData::RawData(std::string pFilename, unsigned int pThreads) :
+	file(pFilename) {
+
+	const char* data = file.data();
+	size_t size = file.size();
+
+	//
+	// Cut the file into newline aligned chunks
+	//
+
+	unsigned int threads = (pThreads > 0 ? pThreads : std::thread::hardware_concurrency());
+	size_t maxChunks = size / _Chunk_Minimum_ + 1;
 
-	std::ifstream inFile(pFilename, std::ios::in);
+	if ((threads == 0) || (threads > maxChunks))
+		threads = static_cast<unsigned int>(maxChunks);
 
-	if (!inFile.is_open()) {
-		crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + pFilename);
+	std::string_view file(data, size);
+	std::vector<std::string_view> chunks;
+	size_t start = 0;
+
+	for (auto t = 1u; t <= threads && start < size; t++) {
+		size_t end = (t == threads ? size : (size / threads) * t);
+
+		if (end < start)
+			end = start;
+
+		auto newline = file.find('\n', end);
+		end = (newline == std::string_view::npos || t == threads ? size : newline + 1);
+
+		chunks.push_back(file.substr(start, end - start));
+		start = end;
 	}
 
-	std::vector<std::string> rawData;
+	//
+	// Index the chunks in parallel
+	//
 
-	std::string line;
+	std::vector<std::vector<std::string_view>> indexes(chunks.size());
 
-	while (std::getline(inFile, line)) {
-		trim(line);
+	if (chunks.size() == 1)
+		indexChunk(chunks[0], &indexes[0]);
+	else {
+		std::vector<std::thread> workers;
 
-		if (line.size() > 0)
-			rawData.push_back(line);
+		for (size_t c = 0; c < chunks.size(); c++)
+			workers.emplace_back(indexChunk, chunks[c], &indexes[c]);
+
+		for (auto& w : workers)
+			w.join();
 	}
 
-	std::cout << "Imported " << rawData.size() << " rows from the file" << std::endl;
+	//
+	// Stitch the chunk indexes together in file order
+	//
 
-	return rawData;
+	size_t totalRows = 0;
+
+	for (auto& index : indexes)
+		totalRows += index.size();
+
+	rowViews.reserve(totalRows);
+
+	for (auto& index : indexes) {
+		rowViews.insert(rowViews.end(), index.begin(), index.end());
+
+		// Release each chunk as it is copied so the peak stays near one index
+		std::vector<std::string_view>().swap(index);
+	}
+
+	LogLine(_LOG_DEBUG_, "Imported").field("rows", static_cast<uint64_t>(rowViews.size()))
+		.field("chunks", static_cast<uint64_t>(chunks.size())).field("file", pFilename);
+}
+
+
+//
+// Function: fieldCount()
+//
+// Parameters:
+//    pRow - Row index
+//
+// Returns:
+//    Number of fields of the row
+//
+
+unsigned int RawData::fieldCount(size_t pRow) const {
+
+	std::vector<std::string_view> rowFields;
+
+	return tokenizeRow(rowViews[pRow], &rowFields);
 }
 
 
+//
+// Function: fields()
+//
+// Parameters:
+//    pRow - Row index
+//    pFields - Cleared and filled with one view per field of the row
+//
+// Returns:
+//    Number of fields
+//
+
+unsigned int RawData::fields(size_t pRow, std::vector<std::string_view>* pFields) const {
+
+	return tokenizeRow(rowViews[pRow], pFields);
+}
+
+
+//
+// Function: importRawData()
+//
+// Parameters:
+//    pFilename - Text file
+//
+// Returns:
+//    Copies of the non-empty, trimmed rows
+//
+
+std::vector<std::string> importRawData(std::string pFilename) {
+
+	RawData file(pFilename);
+
+	std::vector<std::string> rawData;
+	rawData.reserve(file.rows());
+
+	for (size_t r = 0; r < file.rows(); r++)
+		rawData.emplace_back(file.row(r));
+
+	return rawData;
+}
@@ -28,9 +28,87 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Memory mapped RawData, rows and fields are
+ *                     views into the mapping, chunks are trimmed
+ *                     and tokenized in parallel
+ *
+ * 2026-10-19  JJL     Mapping moved to MappedFile
+ *
+ * 2026-10-19  JJL     Fields tokenized on access, only their counts
+ *                     are kept
+ *
+ * 2026-10-19  JJL     Field counts taken on access too, the chunk
+ *                     threads only find the rows
+ *
  */
 
 #pragma once
 
+//
+// Standard Includes
+//
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Local Includes
+//
+
+#include "../Common/MappedFile.h"
+
+
+//
+// Class: RawData
+//
+// Description:
+//    Maps a text file and indexes its non-empty rows.  The file is cut
+//    into newline aligned chunks that are trimmed on separate threads.
+//    Rows are not tokenized there: a view per field is 16 bytes, more
+//    than the text of a typical numeric field, and a count alone would
+//    be thrown away when the caller tokenizes the row to read it, so
+//    fields() and fieldCount() tokenize the row on access.  Rows and
+//    fields are views into the mapping and are valid while the RawData
+//    lives.
+//
+
+class RawData {
+public:
+	RawData(std::string pFilename, unsigned int pThreads = 0);
+
+	RawData(const RawData&) = delete;
+	RawData& operator=(const RawData&) = delete;
+
+	size_t rows() const { return rowViews.size(); }
+	std::string_view row(size_t pRow) const { return rowViews[pRow]; }
+
+	// Tokenizes the row, use fields() with a reused vector in a loop
+	unsigned int fieldCount(size_t pRow) const;
+
+	unsigned int fields(size_t pRow, std::vector<std::string_view>* pFields) const;
+
+private:
+	MappedFile file;
+
+	std::vector<std::string_view> rowViews;
+};
+
+
+//
+// Function: importRawData()
+//
+// Description:
+//    Copies of the non-empty, trimmed rows of a file
+//
+
 std::vector<std::string> importRawData(std::string pFilename);
 
@@ -28,16 +28,19 @@
  *
  * 2014-10-28  JJL     Added Multilevel Monte Carlo
  *
+ * 2026-10-19  JJL     Zero-copy tokenizer returning views into the
+ *                     line, numeric fields parsed with from_chars
+ *
  */
 
 #pragma once
 
-
- //
- // Standard Includes
- //
+//
+// Standard Includes
+//
 
 #include <string>
+#include <string_view>
 
 
 //
@@ -47,5 +50,42 @@
 #include <vector>
 
 
-std::vector<std::string> parseRow(std::string pLine);
+//
+// Function: tokenizeRow()
+//
+// Parameters:
+//    pLine - One CSV row, must outlive the fields
+//    pFields - Cleared and filled with one view per field
+//
+// Returns:
+//    Number of fields.  Commas inside double quotes do not separate
+//    fields.  Fields are trimmed and the enclosing quotes of a quoted
+//    field are removed; doubled quotes inside it are left as they are.
+//
 
+unsigned int tokenizeRow(std::string_view pLine, std::vector<std::string_view>* pFields);
+
+
+//
+// Function: parseField()
+//
+// Parameters:
+//    pField - Field returned by tokenizeRow()
+//    pValue - Parsed value, written on success
+//
+// Returns:
+//    true if the whole field is a number
+//
+
+bool parseField(std::string_view pField, double* pValue);
+
+
+//
+// Function: parseRow()
+//
+// Description:
+//    Copying wrapper around tokenizeRow() for callers that keep the
+//    fields after the line is gone
+//
+
+std::vector<std::string> parseRow(std::string pLine);
@@ -0,0 +1,430 @@
+
+/*
+ * Runtime selection of the compile time specialized path kernels
+ *
+ * Every model, scheme and payoff combination is instantiated here,
+ * once with a run time step count and once for each of the small step
+ * counts used in the convergence studies.  The choice is made once per
+ * pricing, never inside the step loop.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     selectLevelKernel() for multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     Antithetic level kernels
+ *
+ * 2026-10-19  JJL     selectIndexKernel() for multi-index Monte Carlo
+ *
+ * 2026-10-19  JJL     selectQuasiLevelKernel() for multilevel
+ *                     quasi-Monte Carlo
+ *
+ * 2026-10-19  JJL     Adaptive time step level kernels
+ *
+ * 2026-10-19  JJL     Quadratic exponential scheme, qe
+ *
+ * 2026-10-19  JJL     Exact square root transition scheme, exact
+ *
+ * 2026-10-19  JJL     Richardson-Romberg block kernels
+ *
+ * 2026-10-19  JJL     modelFactors()
+ *
+ * 2026-10-19  JJL     selectIndexKernel() removed with -mimc
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "../Common/selectKernel.h"
+#include "../Common/PathKernel.h"
+#include "../Common/Crash.h"
+
+
+//
+// Standard Includes
+//
+
+#include <string>
+
+
+//
+// Function: selectSteps()
+//
+
+template<class Model, class Scheme, class Payoff>
+BlockKernel selectSteps(unsigned int pSteps) {
+
+	switch (pSteps) {
+	case 1:
+		return &simulateBlocks<Model, Scheme, Payoff, 1>;
+	case 2:
+		return &simulateBlocks<Model, Scheme, Payoff, 2>;
+	case 4:
+		return &simulateBlocks<Model, Scheme, Payoff, 4>;
+	case 8:
+		return &simulateBlocks<Model, Scheme, Payoff, 8>;
+	case 12:
+		return &simulateBlocks<Model, Scheme, Payoff, 12>;
+	case 16:
+		return &simulateBlocks<Model, Scheme, Payoff, 16>;
+	default:
+		return &simulateBlocks<Model, Scheme, Payoff, 0>;
+	}
+}
+
+
+//
+// Function: selectPayoff()
+//
+
+template<class Model, class Scheme>
+BlockKernel selectPayoff(std::string pPayoff, unsigned int pSteps) {
+
+	if (pPayoff == "put")
+		return selectSteps<Model, Scheme, EuropeanPut>(pSteps);
+
+	if (pPayoff == "call")
+		return selectSteps<Model, Scheme, EuropeanCall>(pSteps);
+
+	if (pPayoff == "asset")
+		return selectSteps<Model, Scheme, AssetPrice>(pSteps);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown payoff: " + pPayoff);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectScheme()
+//
+
+template<class Model>
+BlockKernel selectScheme(std::string pScheme, std::string pPayoff, unsigned int pSteps) {
+
+	if (pScheme == "em")
+		return selectPayoff<Model, EulerMaruyama>(pPayoff, pSteps);
+
+	if (pScheme == "milstein")
+		return selectPayoff<Model, Milstein>(pPayoff, pSteps);
+
+	if (pScheme == "logeuler")
+		return selectPayoff<Model, LogEuler>(pPayoff, pSteps);
+
+	if (pScheme == "qe")
+		return selectPayoff<Model, QuadraticExponential>(pPayoff, pSteps);
+
+	if (pScheme == "exact")
+		return selectPayoff<Model, ExactCIR>(pPayoff, pSteps);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown scheme: " + pScheme);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectKernel()
+//
+// Parameters:
+//    pModel - gbm, heston or hhw
+//    pScheme - em, milstein, logeuler, qe or exact
+//    pPayoff - put, call or asset
+//    pSteps - Steps per path
+//
+// Returns:
+//    Block kernel instantiated for the combination
+//
+
+BlockKernel selectKernel(std::string pModel, std::string pScheme, std::string pPayoff, unsigned int pSteps) {
+
+	if (pModel == "gbm")
+		return selectScheme<GBM>(pScheme, pPayoff, pSteps);
+
+	if (pModel == "heston")
+		return selectScheme<Heston>(pScheme, pPayoff, pSteps);
+
+	if (pModel == "hhw")
+		return selectScheme<HHW>(pScheme, pPayoff, pSteps);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown model: " + pModel);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectRichardsonPayoff()
+//
+
+template<class Model, class Scheme>
+RichardsonKernel selectRichardsonPayoff(std::string pPayoff) {
+
+	if (pPayoff == "put")
+		return &simulateRichardsonBlocks<Model, Scheme, EuropeanPut>;
+
+	if (pPayoff == "call")
+		return &simulateRichardsonBlocks<Model, Scheme, EuropeanCall>;
+
+	if (pPayoff == "asset")
+		return &simulateRichardsonBlocks<Model, Scheme, AssetPrice>;
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown payoff: " + pPayoff);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectRichardsonScheme()
+//
+
+template<class Model>
+RichardsonKernel selectRichardsonScheme(std::string pScheme, std::string pPayoff) {
+
+	if (pScheme == "em")
+		return selectRichardsonPayoff<Model, EulerMaruyama>(pPayoff);
+
+	if (pScheme == "milstein")
+		return selectRichardsonPayoff<Model, Milstein>(pPayoff);
+
+	if (pScheme == "logeuler")
+		return selectRichardsonPayoff<Model, LogEuler>(pPayoff);
+
+	if (pScheme == "qe")
+		return selectRichardsonPayoff<Model, QuadraticExponential>(pPayoff);
+
+	if (pScheme == "exact")
+		return selectRichardsonPayoff<Model, ExactCIR>(pPayoff);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown scheme: " + pScheme);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectRichardsonKernel()
+//
+
+RichardsonKernel selectRichardsonKernel(std::string pModel, std::string pScheme, std::string pPayoff,
+	unsigned int pRefinements) {
+
+	if ((pRefinements == 0) || (pRefinements > _Richardson_Max_Refinements_))
+		crash(__LINE__, __FILE__, __FUNCTION__, "Richardson refinements "
+			+ std::to_string(pRefinements) + " outside 1 to "
+			+ std::to_string(_Richardson_Max_Refinements_));
+
+	if (pModel == "gbm")
+		return selectRichardsonScheme<GBM>(pScheme, pPayoff);
+
+	if (pModel == "heston")
+		return selectRichardsonScheme<Heston>(pScheme, pPayoff);
+
+	if (pModel == "hhw")
+		return selectRichardsonScheme<HHW>(pScheme, pPayoff);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown model: " + pModel);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectLevelVariant()
+//
+
+template<class Model, class Scheme, class Payoff>
+LevelKernel selectLevelVariant(bool pAntithetic, bool pAdaptive) {
+
+	if (pAntithetic && pAdaptive)
+		crash(__LINE__, __FILE__, __FUNCTION__, "No antithetic estimator with adaptive time steps");
+
+	if (pAdaptive)
+		return &simulateAdaptiveLevel<Model, Scheme, Payoff>;
+
+	if (pAntithetic)
+		return &simulateLevel<Model, Scheme, Payoff, true>;
+
+	return &simulateLevel<Model, Scheme, Payoff, false>;
+}
+
+
+//
+// Function: selectLevelPayoff()
+//
+
+template<class Model, class Scheme>
+LevelKernel selectLevelPayoff(std::string pPayoff, bool pAntithetic, bool pAdaptive) {
+
+	if (pPayoff == "put")
+		return selectLevelVariant<Model, Scheme, EuropeanPut>(pAntithetic, pAdaptive);
+
+	if (pPayoff == "call")
+		return selectLevelVariant<Model, Scheme, EuropeanCall>(pAntithetic, pAdaptive);
+
+	if (pPayoff == "asset")
+		return selectLevelVariant<Model, Scheme, AssetPrice>(pAntithetic, pAdaptive);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown payoff: " + pPayoff);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectLevelScheme()
+//
+
+template<class Model>
+LevelKernel selectLevelScheme(std::string pScheme, std::string pPayoff, bool pAntithetic, bool pAdaptive) {
+
+	if (pScheme == "em")
+		return selectLevelPayoff<Model, EulerMaruyama>(pPayoff, pAntithetic, pAdaptive);
+
+	if (pScheme == "milstein")
+		return selectLevelPayoff<Model, Milstein>(pPayoff, pAntithetic, pAdaptive);
+
+	if (pScheme == "logeuler")
+		return selectLevelPayoff<Model, LogEuler>(pPayoff, pAntithetic, pAdaptive);
+
+	if (pScheme == "qe")
+		return selectLevelPayoff<Model, QuadraticExponential>(pPayoff, pAntithetic, pAdaptive);
+
+	if (pScheme == "exact")
+		return selectLevelPayoff<Model, ExactCIR>(pPayoff, pAntithetic, pAdaptive);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown scheme: " + pScheme);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectLevelKernel()
+//
+
+LevelKernel selectLevelKernel(std::string pModel, std::string pScheme, std::string pPayoff,
+	bool pAntithetic, bool pAdaptive) {
+
+	if (pModel == "gbm")
+		return selectLevelScheme<GBM>(pScheme, pPayoff, pAntithetic, pAdaptive);
+
+	if (pModel == "heston")
+		return selectLevelScheme<Heston>(pScheme, pPayoff, pAntithetic, pAdaptive);
+
+	if (pModel == "hhw")
+		return selectLevelScheme<HHW>(pScheme, pPayoff, pAntithetic, pAdaptive);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown model: " + pModel);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectQuasiLevelPayoff()
+//
+
+template<class Model, class Scheme>
+QuasiLevelKernel selectQuasiLevelPayoff(std::string pPayoff) {
+
+	if (pPayoff == "put")
+		return &simulateQuasiLevel<Model, Scheme, EuropeanPut>;
+
+	if (pPayoff == "call")
+		return &simulateQuasiLevel<Model, Scheme, EuropeanCall>;
+
+	if (pPayoff == "asset")
+		return &simulateQuasiLevel<Model, Scheme, AssetPrice>;
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown payoff: " + pPayoff);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectQuasiLevelScheme()
+//
+
+template<class Model>
+QuasiLevelKernel selectQuasiLevelScheme(std::string pScheme, std::string pPayoff) {
+
+	if (pScheme == "em")
+		return selectQuasiLevelPayoff<Model, EulerMaruyama>(pPayoff);
+
+	if (pScheme == "milstein")
+		return selectQuasiLevelPayoff<Model, Milstein>(pPayoff);
+
+	if (pScheme == "logeuler")
+		return selectQuasiLevelPayoff<Model, LogEuler>(pPayoff);
+
+	if (pScheme == "qe")
+		return selectQuasiLevelPayoff<Model, QuadraticExponential>(pPayoff);
+
+	if (pScheme == "exact")
+		return selectQuasiLevelPayoff<Model, ExactCIR>(pPayoff);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown scheme: " + pScheme);
+
+	return nullptr;
+}
+
+
+//
+// Function: selectQuasiLevelKernel()
+//
+
+QuasiLevelKernel selectQuasiLevelKernel(std::string pModel, std::string pScheme, std::string pPayoff) {
+
+	if (pModel == "gbm")
+		return selectQuasiLevelScheme<GBM>(pScheme, pPayoff);
+
+	if (pModel == "heston")
+		return selectQuasiLevelScheme<Heston>(pScheme, pPayoff);
+
+	if (pModel == "hhw")
+		return selectQuasiLevelScheme<HHW>(pScheme, pPayoff);
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown model: " + pModel);
+
+	return nullptr;
+}
+
+
+//
+// Function: modelFactors()
+//
+
+unsigned int modelFactors(std::string pModel) {
+
+	if (pModel == "gbm")
+		return GBM::Factors;
+
+	if (pModel == "heston")
+		return Heston::Factors;
+
+	if (pModel == "hhw")
+		return HHW::Factors;
+
+	crash(__LINE__, __FILE__, __FUNCTION__, "Unknown model: " + pModel);
+
+	return 0;
+}
+
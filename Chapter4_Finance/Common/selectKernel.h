@@ -0,0 +1,161 @@
+
+/*
+ * Runtime selection of the compile time specialized path kernels
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     selectLevelKernel() for multilevel Monte Carlo
+ *
+ * 2026-10-19  JJL     Antithetic level kernels
+ *
+ * 2026-10-19  JJL     selectIndexKernel() for multi-index Monte Carlo
+ *
+ * 2026-10-19  JJL     selectQuasiLevelKernel() for multilevel
+ *                     quasi-Monte Carlo
+ *
+ * 2026-10-19  JJL     Adaptive time step level kernels
+ *
+ * 2026-10-19  JJL     Quadratic exponential scheme, qe
+ *
+ * 2026-10-19  JJL     Exact square root transition scheme, exact
+ *
+ * 2026-10-19  JJL     selectRichardsonKernel() for Richardson-Romberg
+ *                     extrapolation over step refinements
+ *
+ * 2026-10-19  JJL     modelFactors(), the Brownian motions per step
+ *
+ * 2026-10-19  JJL     selectIndexKernel() removed with -mimc
+ *
+ */
+
+#pragma once
+
+//
+// Standard Includes
+//
+
+#include <cstdint>
+#include <string>
+
+
+//
+// STL Includes
+//
+
+#include <vector>
+
+
+//
+// Local Includes
+//
+
+#include "Simulation.h"
+#include "Partial.h"
+#include "MLMC.h"
+
+
+typedef std::vector<BlockAccumulator> (*BlockKernel)(const SimulationParameters& pP,
+	uint64_t pFirstBlock, uint64_t pLastBlock, uint64_t pSeed);
+
+typedef std::vector<BlockAccumulator> (*RichardsonKernel)(const SimulationParameters& pP,
+	uint64_t pFirstBlock, uint64_t pLastBlock, uint64_t pSeed, unsigned int pRefinements);
+
+typedef LevelSums (*LevelKernel)(const SimulationParameters& pP, unsigned int pLevel,
+	uint64_t pFirst, uint64_t pCount, uint64_t pSeed);
+
+typedef LevelSums (*QuasiLevelKernel)(const SimulationParameters& pP, unsigned int pLevel,
+	unsigned int pRandomization, uint64_t pFirst, uint64_t pCount, uint64_t pSeed);
+
+
+//
+// Function: selectKernel()
+//
+// Parameters:
+//    pModel - gbm, heston or hhw
+//    pScheme - em, milstein, logeuler, qe or exact
+//    pPayoff - put, call or asset
+//    pSteps - Steps per path, 1, 2, 4, 8, 12 and 16 get unrolled kernels
+//
+// Returns:
+//    Block kernel instantiated for the combination, crashes on an
+//    unknown name
+//
+
+BlockKernel selectKernel(std::string pModel, std::string pScheme, std::string pPayoff, unsigned int pSteps);
+
+
+//
+// Function: selectRichardsonKernel()
+//
+// Parameters:
+//    pModel, pScheme, pPayoff - As selectKernel()
+//    pRefinements - Step refinements the kernel will be called with
+//
+// Returns:
+//    Block kernel of the extrapolated payoff over coupled step
+//    refinements, crashes on an unknown name or more refinements than
+//    a path holds
+//
+
+RichardsonKernel selectRichardsonKernel(std::string pModel, std::string pScheme, std::string pPayoff,
+	unsigned int pRefinements);
+
+
+//
+// Function: selectLevelKernel()
+//
+// Parameters:
+//    pModel, pScheme, pPayoff - As selectKernel()
+//    pAntithetic - Average each fine path with its antithetic twin
+//    pAdaptive - Path dependent time steps, see simulateAdaptiveLevel()
+//
+// Returns:
+//    Fine minus coarse level sampler instantiated for the combination,
+//    crashes on an unknown name
+//
+
+LevelKernel selectLevelKernel(std::string pModel, std::string pScheme, std::string pPayoff,
+	bool pAntithetic = false, bool pAdaptive = false);
+
+
+//
+// Function: selectQuasiLevelKernel()
+//
+// Parameters:
+//    pModel, pScheme, pPayoff - As selectKernel()
+//
+// Returns:
+//    Fine minus coarse level sampler on randomized Sobol points,
+//    crashes on an unknown name
+//
+
+QuasiLevelKernel selectQuasiLevelKernel(std::string pModel, std::string pScheme, std::string pPayoff);
+
+
+//
+// Function: modelFactors()
+//
+// Parameters:
+//    pModel - As selectKernel()
+//
+// Returns:
+//    Brownian motions the model consumes per step, crashes on an
+//    unknown name
+//
+
+unsigned int modelFactors(std::string pModel);
+
+
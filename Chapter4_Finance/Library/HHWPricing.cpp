@@ -0,0 +1,207 @@
+
+/*
+ * C interface to the Monte Carlo pricing engine
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Exceptions caught at the C boundary, model
+ *                     parameters validated
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "HHWPricing.h"
+#include "Simulation.h"
+#include "selectKernel.h"
+#include "createMatrix.h"
+#include "Partial.h"
+#include "Welford.h"
+
+
+//
+// Standard Includes
+//
+
+#include <chrono>
+#include <math.h>
+#include <new>
+#include <string>
+
+
+//
+// Kernel names, indexed by the HHW_* constants
+//
+
+static const char* modelNames[] = { "gbm", "heston", "hhw" };
+static const char* schemeNames[] = { "em", "milstein", "logeuler" };
+static const char* payoffNames[] = { "put", "call", "asset" };
+
+
+//
+// Function: validateParameters()
+//
+// Parameters:
+//    pP - Parameter set
+//
+// Returns:
+//    HHW_OKAY or the reason the set cannot be priced.  The engine
+//    crashes on these conditions, which must never happen inside a
+//    host process.
+//
+
+static int32_t validateParameters(const HHWParameters& pP) {
+
+	if ((pP.steps == 0) || (pP.sims == 0) || !(pP.T > 0.0) || !isfinite(pP.T))
+		return HHW_BAD_ARGUMENT;
+
+	const double nonNegative[] = { pP.S0, pP.K, pP.v0, pP.vbar, pP.Kv, pP.Kr, pP.sigmav, pP.sigmar };
+
+	for (auto value : nonNegative)
+		if (!isfinite(value) || (value < 0.0))
+			return HHW_BAD_ARGUMENT;
+
+	if (!isfinite(pP.r0) || !isfinite(pP.rbar))
+		return HHW_BAD_ARGUMENT;
+
+	// Leading principal minors of the correlation matrix
+	double minor2 = 1.0 - pP.rho12 * pP.rho12;
+	double minor3 = 1.0 - pP.rho12 * pP.rho12 - pP.rho13 * pP.rho13 - pP.rho23 * pP.rho23
+		+ 2.0 * pP.rho12 * pP.rho13 * pP.rho23;
+
+	if (!(minor2 > 0.0) || !(minor3 > 0.0))
+		return HHW_BAD_CORRELATION;
+
+	return HHW_OKAY;
+}
+
+
+//
+// Function: priceParameters()
+//
+// Parameters:
+//    pP - Validated parameter set
+//    pModel, pScheme, pPayoff, pSeed - As hhwPriceBatch()
+//    pPrice, pStdError - Price and its standard error, written
+//    pSeconds - Wall clock time, written unless NULL
+//
+// Returns:
+//    Nothing, throws what the engine throws
+//
+
+static void priceParameters(const HHWParameters& pP, int32_t pModel, int32_t pScheme, int32_t pPayoff,
+	uint64_t pSeed, double* pPrice, double* pStdError, double* pSeconds) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	SimulationParameters simulation;
+	simulation.S0 = pP.S0;
+	simulation.v0 = pP.v0;
+	simulation.r0 = pP.r0;
+	simulation.T = pP.T;
+	simulation.K = pP.K;
+	simulation.Kv = pP.Kv;
+	simulation.Kr = pP.Kr;
+	simulation.sigmav = pP.sigmav;
+	simulation.sigmar = pP.sigmar;
+	simulation.vbar = pP.vbar;
+	simulation.rbar = pP.rbar;
+	simulation.actual = 0.0;
+	simulation.steps = pP.steps;
+	simulation.sims = pP.sims;
+	simulation.rho = createMatrix(pP.rho12, pP.rho13, pP.rho23);
+
+	auto kernel = selectKernel(modelNames[pModel], schemeNames[pScheme],
+		payoffNames[pPayoff], pP.steps);
+
+	uint64_t blocks = (static_cast<uint64_t>(pP.sims) + _Partial_Block_Size_ - 1) / _Partial_Block_Size_;
+	auto blockResults = kernel(simulation, 0, blocks, pSeed);
+
+	auto total = emptyBlock(0);
+
+	for (auto b : blockResults)
+		mergeBlock(&total, b);
+
+	double variance = (total.count > 1.0 ? welfordVariance(&total.count, &total.mean, &total.M2) : 0.0);
+
+	*pPrice = total.mean;
+	*pStdError = sqrt(variance / total.count);
+
+	if (pSeconds != nullptr)
+		*pSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+//
+// Function: hhwAbiVersion()
+//
+
+int32_t hhwAbiVersion(void) {
+	return HHW_ABI_VERSION;
+}
+
+
+//
+// Function: hhwPriceBatch()
+//
+// Parameters:
+//    See HHWPricing.h
+//
+// Returns:
+//    HHW_OKAY or the first error found
+//
+
+int32_t hhwPriceBatch(const HHWParameters* pParameters, size_t pCount,
+	int32_t pModel, int32_t pScheme, int32_t pPayoff, uint64_t pSeed,
+	double* pPrices, double* pStdErrors, double* pSeconds) {
+
+	if ((pCount > 0) && ((pParameters == nullptr) || (pPrices == nullptr) || (pStdErrors == nullptr)))
+		return HHW_BAD_ARGUMENT;
+
+	if ((pModel < 0) || (pModel > HHW_MODEL_HHW) ||
+		(pScheme < 0) || (pScheme > HHW_SCHEME_LOGEULER) ||
+		(pPayoff < 0) || (pPayoff > HHW_PAYOFF_ASSET))
+		return HHW_BAD_ARGUMENT;
+
+	for (size_t i = 0; i < pCount; i++) {
+		auto status = validateParameters(pParameters[i]);
+
+		if (status != HHW_OKAY)
+			return status;
+	}
+
+	//
+	// Price every parameter set.  Nothing may throw through the C
+	// interface into the host process.
+	//
+
+	try {
+		for (size_t i = 0; i < pCount; i++)
+			priceParameters(pParameters[i], pModel, pScheme, pPayoff, pSeed, &pPrices[i], &pStdErrors[i],
+				(pSeconds != nullptr ? &pSeconds[i] : nullptr));
+	}
+	catch (const std::bad_alloc&) {
+		return HHW_OUT_OF_MEMORY;
+	}
+	catch (...) {
+		return HHW_INTERNAL_ERROR;
+	}
+
+	return HHW_OKAY;
+}
@@ -0,0 +1,144 @@
+
+/*
+ * C interface to the Monte Carlo pricing engine
+ *
+ * Callers own every buffer.  The parameter array is read in place and
+ * the prices, standard errors and timings are written straight into
+ * the output arrays, so a risk system can price a whole book with one
+ * call and no copies.  Only fixed width C types cross the interface
+ * and the layout of HHWParameters only ever grows at the end, with
+ * HHW_ABI_VERSION bumped when it does.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     HHW_OUT_OF_MEMORY and HHW_INTERNAL_ERROR, model
+ *                     parameters validated
+ *
+ */
+
+#ifndef HHW_PRICING_H
+#define HHW_PRICING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//
+// Definitions
+//
+
+#define HHW_ABI_VERSION        1
+
+#if defined(_WIN32)
+#define HHW_EXPORT __declspec(dllexport)
+#else
+#define HHW_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define HHW_OKAY               0
+#define HHW_BAD_ARGUMENT       1
+#define HHW_BAD_CORRELATION    2
+#define HHW_OUT_OF_MEMORY      3
+#define HHW_INTERNAL_ERROR     4
+
+#define HHW_MODEL_GBM          0
+#define HHW_MODEL_HESTON       1
+#define HHW_MODEL_HHW          2
+
+#define HHW_SCHEME_EM          0
+#define HHW_SCHEME_MILSTEIN    1
+#define HHW_SCHEME_LOGEULER    2
+
+#define HHW_PAYOFF_PUT         0
+#define HHW_PAYOFF_CALL        1
+#define HHW_PAYOFF_ASSET       2
+
+
+//
+// Structure: HHWParameters
+//
+// Description:
+//    One parameter set, same meaning as SimulationParameters in
+//    Common/Simulation.h with the correlations given pairwise.
+//
+
+typedef struct HHWParameters {
+	double S0;
+	double v0;
+	double r0;
+	double T;
+	double K;
+	double Kv;
+	double Kr;
+	double sigmav;
+	double sigmar;
+	double vbar;
+	double rbar;
+	double rho12;
+	double rho13;
+	double rho23;
+	uint32_t steps;
+	uint32_t sims;
+} HHWParameters;
+
+
+//
+// Function: hhwAbiVersion()
+//
+// Returns:
+//    HHW_ABI_VERSION of the library that was loaded
+//
+
+HHW_EXPORT int32_t hhwAbiVersion(void);
+
+
+//
+// Function: hhwPriceBatch()
+//
+// Parameters:
+//    pParameters - pCount parameter sets
+//    pCount - Number of parameter sets
+//    pModel, pScheme, pPayoff - HHW_MODEL_*, HHW_SCHEME_*, HHW_PAYOFF_*
+//    pSeed - Seed of the path addressed random numbers
+//    pPrices - pCount prices, written
+//    pStdErrors - pCount standard errors of the prices, written
+//    pSeconds - pCount wall clock times, may be NULL
+//
+// Returns:
+//    HHW_OKAY, or the first error found.  Parameter sets are validated
+//    before any pricing starts, so on HHW_BAD_ARGUMENT or
+//    HHW_BAD_CORRELATION no output is written.  S0, K, v0, vbar, Kv,
+//    Kr, sigmav and sigmar must be finite and non-negative, r0 and
+//    rbar finite.  HHW_OUT_OF_MEMORY and HHW_INTERNAL_ERROR stop the
+//    batch where they occur, the outputs of the sets before it are
+//    written and those after it are not.  No C++ exception leaves the
+//    call.
+//
+
+HHW_EXPORT int32_t hhwPriceBatch(const HHWParameters* pParameters, size_t pCount,
+	int32_t pModel, int32_t pScheme, int32_t pPayoff, uint64_t pSeed,
+	double* pPrices, double* pStdErrors, double* pSeconds);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+
+/*
+ * Prices two parameter sets through the C interface
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+#include <stdio.h>
+
+#include "HHWPricing.h"
+
+int main(void) {
+
+	HHWParameters book[2] = {
+		{ 100.0, 0.01, 0.04, 0.25, 100.0, 1.5, 0.1, 0.15, 0.01, 0.01, 0.04, 0.1, 0.0, 0.0, 64, 100000 },
+		{ 100.0, 0.01, 0.04, 0.25, 90.0, 1.5, 0.1, 0.15, 0.01, 0.01, 0.04, 0.1, 0.0, 0.0, 64, 100000 }
+	};
+
+	double prices[2], stdErrors[2], seconds[2];
+
+	if (hhwAbiVersion() != HHW_ABI_VERSION) {
+		fprintf(stderr, "Library ABI %d, expected %d\n", hhwAbiVersion(), HHW_ABI_VERSION);
+		return 1;
+	}
+
+	int status = hhwPriceBatch(book, 2, HHW_MODEL_HHW, HHW_SCHEME_EM, HHW_PAYOFF_PUT, 1,
+		prices, stdErrors, seconds);
+
+	if (status != HHW_OKAY) {
+		fprintf(stderr, "hhwPriceBatch failed with %d\n", status);
+		return 1;
+	}
+
+	for (int i = 0; i < 2; i++)
+		printf("K = %g : price = %f : std error = %f : seconds = %f\n",
+			book[i].K, prices[i], stdErrors[i], seconds[i]);
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Merge the partial results of a sharded Monte Carlo pricing
+ *
+ * Usage:
+ *    MergePartials partial.0.bin partial.1.bin ... partial.n.bin
+ *
+ * Every shard of the pricing must be present.  Missing, duplicated or
+ * mismatched shards are reported and nothing is estimated, since an
+ * estimate from a subset of the paths would be silently biased.
+ *
+ * See also
+ * Lay, H., Colgin, Z., Reshniak, V., Khaliq, A.Q.M. (2018).
+ * "On the implementation of multilevel Monte Carlo simulation
+ * of the stochastic volatility and interest rate model using
+ * multi-GPU clusters." Monte Carlo Methods and Applications,
+ * 24(4), pp. 309-321.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ * 2026-10-19  JJL     Block ids checked against the shard, quantiles
+ *                     from the merged sketch
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "ReturnValues.h"
+#include "Partial.h"
+#include "Welford.h"
+#include "Crash.h"
+
+
+//
+// Standard includes
+//
+
+#include <iostream>
+#include <string>
+
+
+//
+// STL includes
+//
+
+#include <algorithm>
+#include <vector>
+
+
+//
+// Function: main()
+//
+// Parameters:
+//    argc - Number of commandline arguments
+//    argv - Partial result files
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+int main(int argc, char* argv[]) {
+
+	std::vector<std::string> files;
+
+	for (auto i = 1; i < argc; i++)
+		files.push_back(argv[i]);
+
+	if (files.size() == 0) {
+		std::cerr << "Usage: " << argv[0] << " partial.0.bin ... partial.n.bin" << std::endl;
+		return _FAIL_;
+	}
+
+	//
+	// Read and validate every partial
+	//
+
+	PartialHeader reference;
+	std::vector<BlockAccumulator> blocks;
+	std::vector<std::string> owner;
+
+	for (auto f = 0u; f < files.size(); f++) {
+		auto partial = readPartial(files[f]);
+		auto header = std::get<0>(partial);
+		auto records = std::get<1>(partial);
+
+		if (f == 0) {
+			reference = header;
+			owner.assign(header.shards, "");
+		}
+
+		if ((header.shards != reference.shards) || (header.seed != reference.seed) ||
+			(header.sims != reference.sims) || (header.steps != reference.steps) ||
+			(header.blockSize != reference.blockSize) || (header.blocks != reference.blocks) ||
+			(header.parameterHash != reference.parameterHash)) {
+			crash(__LINE__, __FILE__, __FUNCTION__, files[f] + " belongs to a different pricing than " + files[0]);
+		}
+
+		if (header.shard >= header.shards) {
+			crash(__LINE__, __FILE__, __FUNCTION__, files[f] + " holds shard " + std::to_string(header.shard)
+				+ " of only " + std::to_string(header.shards));
+		}
+
+		if (owner[header.shard].length() > 0) {
+			crash(__LINE__, __FILE__, __FUNCTION__, "Shard " + std::to_string(header.shard)
+				+ " appears in both " + owner[header.shard] + " and " + files[f]);
+		}
+
+		owner[header.shard] = files[f];
+
+		auto range = shardBlocks(header.shard, header.shards, header.blocks);
+
+		if (records.size() != std::get<_Shard_Last_>(range) - std::get<_Shard_First_>(range)) {
+			crash(__LINE__, __FILE__, __FUNCTION__, files[f] + " is missing blocks of shard "
+				+ std::to_string(header.shard));
+		}
+
+		for (auto& record : records) {
+			if ((record.block < std::get<_Shard_First_>(range)) || (record.block >= std::get<_Shard_Last_>(range))) {
+				crash(__LINE__, __FILE__, __FUNCTION__, files[f] + " holds block " + std::to_string(record.block)
+					+ " outside blocks " + std::to_string(std::get<_Shard_First_>(range)) + " to "
+					+ std::to_string(std::get<_Shard_Last_>(range) - 1) + " of shard " + std::to_string(header.shard));
+			}
+		}
+
+		blocks.insert(blocks.end(), records.begin(), records.end());
+	}
+
+	//
+	// Report missing shards
+	//
+
+	unsigned int missing = 0;
+
+	for (auto s = 0u; s < owner.size(); s++) {
+		if (owner[s].length() == 0) {
+			std::cerr << "Missing shard " << s << "/" << reference.shards << std::endl;
+			missing++;
+		}
+	}
+
+	if (missing > 0) {
+		std::cerr << missing << " of " << reference.shards
+			<< " shards are missing, no estimate produced" << std::endl;
+		return _FAIL_;
+	}
+
+	//
+	// Merge in block order, exactly as a single run does
+	//
+
+	std::sort(blocks.begin(), blocks.end(),
+		[](const BlockAccumulator& a, const BlockAccumulator& b) { return a.block < b.block; });
+
+	auto total = emptyBlock(0);
+
+	for (size_t b = 0; b < blocks.size(); b++) {
+		if (blocks[b].block != b) {
+			crash(__LINE__, __FILE__, __FUNCTION__, "Block " + std::to_string(b)
+				+ " is missing and another block appears twice");
+		}
+
+		mergeBlock(&total, blocks[b]);
+	}
+
+	double samples = total.count;
+	double variance = (samples > 1.0 ? welfordVariance(&total.count, &total.mean, &total.M2) : 0.0);
+
+	//
+	// Display results
+	//
+
+	std::cout << std::endl << "======================" << std::endl
+		<< "Merged Results" << std::endl
+		<< "======================" << std::endl
+		<< "Shards = " << reference.shards << std::endl
+		<< "Mean = " << total.mean << std::endl
+		<< "Variance = " << variance << std::endl
+		<< "Samples = " << samples << std::endl
+		<< "Minimum = " << total.minimum << std::endl
+		<< "Maximum = " << total.maximum << std::endl
+		<< "5% Quantile = " << sketchQuantile(total, 0.05) << std::endl
+		<< "Median = " << sketchQuantile(total, 0.5) << std::endl
+		<< "95% Quantile = " << sketchQuantile(total, 0.95) << std::endl << std::endl;
+
+	if (reference.actual != 0.0) {
+		std::cout << "Weak Error = " << total.sumError / samples << std::endl
+			<< "Strong Error = " << total.mean - reference.actual << std::endl;
+	}
+
+	return _OKAY_;
+}
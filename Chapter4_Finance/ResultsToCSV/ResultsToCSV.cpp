@@ -0,0 +1,98 @@
+/*
+ * Convert a columnar result file to CSV
+ *
+ * Usage:
+ *    ResultsToCSV results.bin [results.csv]
+ *
+ * Writes one line per committed row, in row order, to the given file
+ * or to stdout.  Rows a worker has reserved but not finished are
+ * skipped and counted on stderr.
+ *
+ * JJ Lay
+ * Middle Tennessee State University
+ * October 2026
+ *
+ * DATE        AUTHOR  COMMENTS
+ * ----------  ------  ---------------
+ * 2026-10-19  JJL     Initial version
+ *
+ */
+
+
+//
+// Local Includes
+//
+
+#include "ReturnValues.h"
+#include "ResultStore.h"
+#include "Crash.h"
+
+
+//
+// Standard includes
+//
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+//
+// Function: main()
+//
+// Parameters:
+//    argc - Number of commandline arguments
+//    argv - Result file and optional CSV file
+//
+// Returns:
+//    Completion status (see ReturnValues.h)
+//
+
+int main(int argc, char* argv[]) {
+
+	if ((argc < 2) || (argc > 3)) {
+		std::cerr << "Usage: " << argv[0] << " results.bin [results.csv]" << std::endl;
+		return _FAIL_;
+	}
+
+	ResultStore store(argv[1]);
+
+	std::ofstream outFile;
+
+	if (argc == 3) {
+		outFile.open(argv[2], std::ios::out | std::ios::trunc);
+
+		if (!outFile.is_open())
+			crash(__LINE__, __FILE__, __FUNCTION__, "Unable to open " + std::string(argv[2]));
+	}
+
+	std::ostream& out = (argc == 3 ? outFile : std::cout);
+
+	out << std::setprecision(17);
+	out << "Row, ParameterSet, Mean, Variance, N, Steps, WeakError, StrongError" << "\n";
+
+	uint64_t pending = 0;
+
+	for (uint64_t r = 0; r < store.rows(); r++) {
+		if (!store.committed(r)) {
+			pending++;
+			continue;
+		}
+
+		out << r << ", " << store.parameterSet(r)
+			<< ", " << store.value(r, _RESULT_MEAN_)
+			<< ", " << store.value(r, _RESULT_VAR_)
+			<< ", " << store.value(r, _RESULT_N_)
+			<< ", " << store.value(r, _RESULT_STEPS_)
+			<< ", " << store.value(r, _ERROR_WEAK_)
+			<< ", " << store.value(r, _ERROR_STRONG_) << "\n";
+	}
+
+	out.flush();
+
+	if (pending > 0)
+		std::cerr << pending << " rows are still being written and were skipped" << std::endl;
+
+	return _OKAY_;
+}
@@ -30,7 +30,10 @@ int main(int argc, char* argv[]) {
 
 	double alpha = 0.1, beta = 0.1, gamma = 0.1;
 
-	auto data = new double[24];
+	// Every buffer of the forecast is released with the arena
+	Arena arena;
+
+	auto data = arena.allocate<double>(24);
 
 	for (auto i = 0; i < 24; i++) {
 		auto s = pins[i][1];
@@ -38,7 +41,7 @@ int main(int argc, char* argv[]) {
 	}
 
 	// Perform the forecast
-	auto forecasts = triple(data, 24, 12, alpha, beta, gamma);
+	auto forecasts = triple(data, 24, 12, alpha, beta, gamma, &arena);
 
 	return _OKAY_;
 }
@@ -19,18 +19,22 @@
 
 #include "regression.h"
 #include "common.h"
+#include "forecast.h"
 
 
 //
 // Function: triple()
 //
+// Parameters:
+//    pArena - Owns the returned forecasts and the scratch buffers
+//
 
-double *triple(double* pData, int pLen, int cycle, double pAlpha, double pBeta, double pGamma) {
+double *triple(double* pData, int pLen, int cycle, double pAlpha, double pBeta, double pGamma, Arena* pArena) {
 
-	auto forecasts = new double[12];
+	auto forecasts = pArena->allocate<double>(12);
 
-	auto X = new double[pLen];
-	auto Yhat = new double[pLen];
+	auto X = pArena->allocate<double>(pLen);
+	auto Yhat = pArena->allocate<double>(pLen);
 
 	for (auto x = 1; x <= pLen; x++)
 		X[x-1] = static_cast<double>(x);
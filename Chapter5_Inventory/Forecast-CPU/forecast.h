@@ -1,4 +1,10 @@
 #pragma once
 
+//
+// Local includes
+//
 
-double* triple(double* pData, int pLen, int cycle, double pAlpha, double pBeta, double pGamma);
+#include "../../Chapter4_Finance/Common/Arena.h"
+
+
+double* triple(double* pData, int pLen, int cycle, double pAlpha, double pBeta, double pGamma, Arena* pArena);
@@ -12,14 +12,14 @@
 //
 
 #include <string>
+#include <string_view>
 
 
 //
 // Local includes
 //
 
-#include "importRawData.h"
-#include "parseRow.h"
+#include "../../Chapter4_Finance/Common/importRawData.h"
 
 
 //
@@ -29,14 +29,16 @@
 
 std::vector<std::vector<std::string>> importPINS(std::string pFilename) {
 
-	auto rawData = importRawData(pFilename);
+	RawData rawData(pFilename);
 	std::vector<std::vector<std::string>> result;
+	result.reserve(rawData.rows());
 
-	for (auto v : rawData) {
-		auto p = parseRow(v);
-		result.push_back(p);
+	std::vector<std::string_view> fields;
+
+	for (size_t r = 0; r < rawData.rows(); r++) {
+		rawData.fields(r, &fields);
+		result.emplace_back(fields.begin(), fields.end());
 	}
 
 	return result;
 }
-